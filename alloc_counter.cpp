@@ -0,0 +1,159 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+#include "alloc_counter.h"
+#include <cstdlib>
+#include <new>
+
+namespace alloc_counter
+{
+    static thread_local bool counting_thread = false;
+    static counts total;
+    static counts tick_start;
+    static counts last_tick;
+    static probe_stats probes[MAX_PROBES];
+    static int probe_count = 0;
+
+    inline void record_allocation(std::size_t size)
+    {
+        if (!counting_thread)
+            return;
+        total.allocations++;
+        total.bytes += size;
+    }
+
+    void load()
+    {
+        counting_thread = true;
+        tick_start = total;
+    }
+
+    bool is_compiled_in()
+    {
+#ifdef LUVVY_COUNT_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    counts end_tick()
+    {
+        last_tick.allocations = total.allocations - tick_start.allocations;
+        last_tick.bytes = total.bytes - tick_start.bytes;
+        tick_start = total;
+
+        for (int i = 0; i < probe_count; ++i)
+        {
+            probes[i].last_tick = probes[i].current_tick;
+            probes[i].current_tick = counts{};
+        }
+        return last_tick;
+    }
+
+    // Drop allocations since the last tick boundary (used for the counter's own bookkeeping)
+    void discard()
+    {
+        tick_start = total;
+    }
+
+    counts get_last_tick()
+    {
+        return last_tick;
+    }
+
+    const probe_stats* get_probes(int* count)
+    {
+        if (count)
+            *count = probe_count;
+        return probes;
+    }
+
+#ifdef LUVVY_COUNT_ALLOCATIONS
+    int find_probe(const char* name)
+    {
+        // Probe names are string literals, pointer identity is enough
+        for (int i = 0; i < probe_count; ++i)
+        {
+            if (probes[i].name == name)
+                return i;
+        }
+        if (probe_count == MAX_PROBES)
+            return -1;
+        probes[probe_count].name = name;
+        return probe_count++;
+    }
+
+    probe::probe(const char* name) : index(find_probe(name)), start(total)
+    {
+    }
+
+    probe::~probe()
+    {
+        if (index < 0)
+            return;
+        probes[index].current_tick.allocations += total.allocations - start.allocations;
+        probes[index].current_tick.bytes += total.bytes - start.bytes;
+    }
+#endif
+}
+
+#ifdef LUVVY_COUNT_ALLOCATIONS
+void* operator new(std::size_t size)
+{
+    alloc_counter::record_allocation(size);
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    alloc_counter::record_allocation(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+    return operator new(size, tag);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    alloc_counter::record_allocation(size);
+#ifdef _MSC_VER
+    void* p = _aligned_malloc(size ? size : 1, static_cast<std::size_t>(alignment));
+#else
+    std::size_t align = static_cast<std::size_t>(alignment);
+    void* p = std::aligned_alloc(align, ((size ? size : 1) + align - 1) & ~(align - 1));
+#endif
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+#ifdef _MSC_VER
+void operator delete(void* p, std::align_val_t) noexcept { _aligned_free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { _aligned_free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { _aligned_free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { _aligned_free(p); }
+#else
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+#endif
+#endif
@@ -0,0 +1,50 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+
+#pragma once
+
+// Build with LUVVY_COUNT_ALLOCATIONS defined to replace global operator new/delete with counting versions.
+// Without it every function below is a no-op and probes compile away.
+
+namespace alloc_counter
+{
+    constexpr int MAX_PROBES = 16;
+
+    struct counts
+    {
+        std::uint64_t allocations = 0;
+        std::uint64_t bytes = 0;
+    };
+
+    struct probe_stats
+    {
+        const char* name = nullptr;
+        counts last_tick;
+        counts current_tick;
+    };
+
+    // Only allocations made on the thread that called load() are counted
+    //
+    void load();
+    bool is_compiled_in();
+
+    // Tick accounting, driven from the frame start callback
+    //
+    counts end_tick();
+    void discard();
+    counts get_last_tick();
+    const probe_stats* get_probes(int* count);
+
+    // Scoped probe: attributes allocations made inside the scope to `name` (a string literal)
+    struct probe
+    {
+#ifdef LUVVY_COUNT_ALLOCATIONS
+        explicit probe(const char* name);
+        ~probe();
+
+        int index;
+        counts start;
+#else
+        explicit probe(const char*) {}
+#endif
+    };
+};
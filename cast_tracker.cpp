@@ -0,0 +1,168 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+#include "cast_tracker.h"
+#include "logger.h"
+#include <algorithm>
+
+namespace cast_tracker
+{
+    struct slot_state
+    {
+        // FIFO of issue times, oldest at pending_head
+        float pending[MAX_PENDING] = {};
+        int pending_head = 0;
+        int pending_count = 0;
+        int histogram[BUCKETS + 1] = {};
+        int samples = 0;
+        int since_decay = 0;
+        int unconfirmed = 0;
+        float throttle = sciprt_spell_wait;
+    };
+
+    static slot_state slots[MAX_SLOTS];
+
+    static int slot_index(spellslot slot)
+    {
+        int index = static_cast<int>(slot);
+        return index >= 0 && index < MAX_SLOTS ? index : -1;
+    }
+
+    static float percentile(const slot_state& state, float fraction)
+    {
+        int total = 0;
+        for (int count : state.histogram)
+            total += count;
+        if (total == 0)
+            return 0.0f;
+
+        int wanted = static_cast<int>(total * fraction + 0.5f);
+        int seen = 0;
+        for (int i = 0; i <= BUCKETS; ++i)
+        {
+            seen += state.histogram[i];
+            if (seen >= wanted)
+                return (i + 1) * BUCKET_SECONDS;
+        }
+        return (BUCKETS + 1) * BUCKET_SECONDS;
+    }
+
+    static float oldest_pending(const slot_state& state)
+    {
+        return state.pending[state.pending_head];
+    }
+
+    static float newest_pending(const slot_state& state)
+    {
+        return state.pending[(state.pending_head + state.pending_count - 1) % MAX_PENDING];
+    }
+
+    static void pop_pending(slot_state& state)
+    {
+        state.pending_head = (state.pending_head + 1) % MAX_PENDING;
+        state.pending_count--;
+    }
+
+    // Drops pending casts that were never confirmed (interrupted, out of mana, server rejected them)
+    static void expire(slot_state& state, float now)
+    {
+        while (state.pending_count > 0 && now - oldest_pending(state) >= CONFIRM_TIMEOUT)
+        {
+            pop_pending(state);
+            state.unconfirmed++;
+        }
+    }
+
+    void on_process_spell_cast(game_object_script sender, spell_instance_script spell)
+    {
+        if (!sender || !sender->is_me() || !spell || spell->is_auto_attack())
+            return;
+
+        int index = slot_index(spell->get_spellslot());
+        if (index < 0)
+            return;
+
+        auto& state = slots[index];
+        float now = gametime->get_time();
+        expire(state, now);
+        if (state.pending_count == 0)
+            return;
+
+        // Matched to the oldest outstanding cast, so a late confirmation is never timed against a newer re-issue
+        float latency = now - oldest_pending(state);
+        pop_pending(state);
+        state.histogram[std::min(static_cast<int>(latency / BUCKET_SECONDS), BUCKETS)]++;
+        state.samples++;
+        if (++state.since_decay >= DECAY_SAMPLES)
+        {
+            for (int& count : state.histogram)
+                count /= 2;
+            state.since_decay = 0;
+        }
+
+        if (state.samples >= MIN_SAMPLES)
+            state.throttle = std::clamp(percentile(state, 0.95f), MIN_THROTTLE, MAX_THROTTLE);
+        LUVVY_LOG(logger::level::trace, logger::make_message("cast confirmed ms", static_cast<std::int32_t>(latency * 1000.0f)));
+    }
+
+    void load()
+    {
+        for (auto& state : slots)
+            state = slot_state{};
+        event_handler<events::on_process_spell_cast>::add_callback(on_process_spell_cast);
+    }
+
+    void unload()
+    {
+        event_handler<events::on_process_spell_cast>::remove_handler(on_process_spell_cast);
+    }
+
+    bool can_cast(spellslot slot)
+    {
+        int index = slot_index(slot);
+        if (index < 0)
+            return true;
+
+        auto& state = slots[index];
+        float now = gametime->get_time();
+        expire(state, now);
+        return state.pending_count == 0 || now - newest_pending(state) >= state.throttle;
+    }
+
+    void issued(spellslot slot)
+    {
+        int index = slot_index(slot);
+        if (index < 0)
+            return;
+
+        // A full queue gives up on its oldest cast
+        auto& state = slots[index];
+        if (state.pending_count == MAX_PENDING)
+        {
+            pop_pending(state);
+            state.unconfirmed++;
+        }
+        state.pending[(state.pending_head + state.pending_count) % MAX_PENDING] = gametime->get_time();
+        state.pending_count++;
+    }
+
+    float get_throttle(spellslot slot)
+    {
+        int index = slot_index(slot);
+        return index < 0 ? sciprt_spell_wait : slots[index].throttle;
+    }
+
+    slot_stats get_stats(spellslot slot)
+    {
+        slot_stats stats;
+        int index = slot_index(slot);
+        if (index < 0)
+            return stats;
+
+        auto& state = slots[index];
+        expire(state, gametime->get_time());
+        stats.samples = state.samples;
+        stats.unconfirmed = state.unconfirmed;
+        stats.p50 = percentile(state, 0.5f);
+        stats.p95 = percentile(state, 0.95f);
+        return stats;
+    }
+}
@@ -0,0 +1,41 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+
+#pragma once
+namespace cast_tracker
+{
+    constexpr int MAX_SLOTS = 6;            // q, w, e, r, summoner1, summoner2
+    constexpr float BUCKET_SECONDS = 0.01f;
+    constexpr int BUCKETS = 50;             // plus one overflow bucket for everything past 0.5 s
+    constexpr float CONFIRM_TIMEOUT = 1.0f;
+    // Outstanding casts per slot, confirmations are matched oldest first
+    constexpr int MAX_PENDING = 4;
+    constexpr int MIN_SAMPLES = 8;
+    // Histograms are halved after this many samples so the p95 follows changing ping
+    constexpr int DECAY_SAMPLES = 256;
+    constexpr float MIN_THROTTLE = 0.03f;
+    constexpr float MAX_THROTTLE = 0.5f;
+
+    struct slot_stats
+    {
+        int samples = 0;
+        int unconfirmed = 0;
+        float p50 = 0.0f;
+        float p95 = 0.0f;
+    };
+
+    // Tracker lifetime
+    //
+    void load();
+    void unload();
+
+    // Throttle: a new cast waits while the newest one on the slot is unconfirmed and younger
+    // than the slot's measured p95 round trip (sciprt_spell_wait until enough samples exist)
+    //
+    bool can_cast(spellslot slot);
+    void issued(spellslot slot);
+    float get_throttle(spellslot slot);
+
+    // Telemetry
+    //
+    slot_stats get_stats(spellslot slot);
+};
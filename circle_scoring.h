@@ -0,0 +1,52 @@
+#pragma once
+
+// Circle AoE scoring kernel. Kept free of the SDK so tools/tuner.cpp replays recorded farm ticks with
+// exactly the arithmetic the plugin uses; parallel::score_circles only spreads it over the pool.
+namespace circle_scoring
+{
+    struct point
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+        bool killable = false;
+    };
+
+    // counts[i] / scores[i] for centers[begin, end): units inside the circle, plus kill_weight per killable unit
+    inline void score_range(const point* centers, int begin, int end, const point* units, int unit_count,
+        float radius, float kill_weight, int* counts, float* scores)
+    {
+        float radius_sq = radius * radius;
+        for (int i = begin; i < end; ++i)
+        {
+            const auto& c = centers[i];
+            int count = 0;
+            int kills = 0;
+            for (int j = 0; j < unit_count; ++j)
+            {
+                float dx = units[j].x - c.x, dy = units[j].y - c.y;
+                if (dx * dx + dy * dy > radius_sq)
+                    continue;
+                count++;
+                if (units[j].killable) kills++;
+            }
+            counts[i] = count;
+            scores[i] = count + kills * kill_weight;
+        }
+    }
+
+    // Index of the highest score (lowest index on ties), -1 if nothing scored
+    inline int pick_best(const float* scores, int count)
+    {
+        int best = -1;
+        float best_score = 0.0f;
+        for (int i = 0; i < count; ++i)
+        {
+            if (scores[i] > best_score)
+            {
+                best_score = scores[i];
+                best = i;
+            }
+        }
+        return best;
+    }
+}
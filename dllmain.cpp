@@ -8,6 +8,19 @@
 #include "taliyah.h"
 #include "yunara.h"
 #include "utils.h"
+#include "turrets.h"
+#include "forecast.h"
+#include "movement.h"
+#include "jungle.h"
+#include "waves.h"
+#include "cast_tracker.h"
+#include "minion_health.h"
+#include "logger.h"
+#include "telemetry.h"
+#include "worker.h"
+#include "parallel.h"
+#include "tuner.h"
+#include "hero_table.h"
 #include "permashow.hpp"
 
 PLUGIN_NAME("Luvvy AIO ");
@@ -56,6 +69,21 @@ extern "C" PLUGIN_API bool on_sdk_load(plugin_sdk_core* sdk_core)
     }
 
 
+    logger::start(champion);
+    telemetry::start(champion);
+    utils::frame_arena_load();
+    utils::handles_load();
+    parallel::load();
+    turrets::load();
+    forecast::load();
+    movement::load();
+    jungle::load();
+    waves::load();
+    cast_tracker::load();
+    minion_health::load();
+    tuner::load();
+    hero_table::load();
+
     if (champion_load) champion_load();
     return true;
 }
@@ -64,4 +92,20 @@ extern "C" PLUGIN_API void on_sdk_unload()
 {
 
     if (champion_unload) champion_unload();
+
+    hero_table::unload();
+    tuner::unload();
+    worker::unload();
+    parallel::unload();
+    minion_health::unload();
+    cast_tracker::unload();
+    waves::unload();
+    jungle::unload();
+    movement::unload();
+    forecast::unload();
+    turrets::unload();
+    utils::handles_unload();
+    utils::frame_arena_unload();
+    telemetry::stop();
+    logger::stop();
 }
@@ -0,0 +1,315 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+#include "forecast.h"
+#include "alloc_counter.h"
+#include "watchdog.h"
+#include "utils.h"
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+namespace forecast
+{
+    constexpr int MAX_THREATS = 64;
+    constexpr float DEFAULT_CAST_DELAY = 0.25f;
+    constexpr float DEFAULT_CIRCLE_RADIUS = 200.0f;
+    constexpr float MAX_THREAT_LIFETIME = 1.5f;
+
+    enum class threat_shape
+    {
+        targeted,
+        line,
+        circle
+    };
+
+    struct threat
+    {
+        bool active = false;
+        threat_shape shape = threat_shape::targeted;
+        // Turrets get destroyed while their shots are still tracked
+        utils::entity_handle sender;
+        spellslot slot = spellslot::invalid;
+        bool is_auto_attack = false;
+        std::uint32_t sender_id = 0;
+        std::uint32_t target_id = 0;
+        std::uint32_t missile_id = 0;
+        float start_x = 0.0f, start_y = 0.0f;
+        float end_x = 0.0f, end_y = 0.0f;
+        float width = 0.0f;
+        float speed = 0.0f;
+        float launch_time = 0.0f;
+        float expire_time = 0.0f;
+    };
+
+    // Allied heroes are never deleted mid-game, a plain reference is safe here
+    struct ally_forecast
+    {
+        game_object_script hero = nullptr;
+        std::uint32_t id = 0;
+        std::array<float, HORIZON_COUNT> damage = {};
+    };
+
+    // Fixed ring buffer; the oldest threat is overwritten when full, which keeps the per-tick update bounded
+    static std::array<threat, MAX_THREATS> threats;
+    static int threat_head = 0;
+    static std::vector<ally_forecast> allies;
+
+    threat& push_threat()
+    {
+        auto& slot = threats[threat_head];
+        threat_head = (threat_head + 1) % MAX_THREATS;
+        slot = threat{};
+        return slot;
+    }
+
+    // Seconds until the threat reaches `pos`, or a negative value if it misses
+    float time_to_hit(const threat& t, const vector& pos, float bounding_radius, float now)
+    {
+        float px = pos.x, py = pos.y;
+        switch (t.shape)
+        {
+            case threat_shape::targeted:
+            {
+                float travel = t.speed > 0.0f ? pos.distance(vector(t.start_x, t.start_y)) / t.speed : 0.0f;
+                return t.launch_time + travel - now;
+            }
+            case threat_shape::circle:
+            {
+                float dx = px - t.end_x, dy = py - t.end_y;
+                float reach = t.width + bounding_radius;
+                if (dx * dx + dy * dy > reach * reach)
+                    return -1.0f;
+                return t.launch_time - now;
+            }
+            case threat_shape::line:
+            {
+                // Project onto the segment and test the perpendicular distance against half width
+                float sx = t.end_x - t.start_x, sy = t.end_y - t.start_y;
+                float len_sq = sx * sx + sy * sy;
+                float along = len_sq > 0.0f ? ((px - t.start_x) * sx + (py - t.start_y) * sy) / len_sq : 0.0f;
+                if (along < 0.0f || along > 1.0f)
+                    return -1.0f;
+                float cx = t.start_x + sx * along - px, cy = t.start_y + sy * along - py;
+                float reach = t.width * 0.5f + bounding_radius;
+                if (cx * cx + cy * cy > reach * reach)
+                    return -1.0f;
+                float travel = t.speed > 0.0f ? std::sqrt(len_sq) * along / t.speed : 0.0f;
+                return t.launch_time + travel - now;
+            }
+        }
+        return -1.0f;
+    }
+
+    float estimate_damage(const threat& t, const game_object_script& ally)
+    {
+        auto sender = utils::resolve(t.sender);
+        if (!sender || !sender->is_valid())
+            return 0.0f;
+        if (t.is_auto_attack)
+            return damagelib->get_auto_attack_damage(sender, ally, true);
+        return damagelib->get_spell_damage(sender, ally, t.slot, false);
+    }
+
+    void on_update()
+    {
+        alloc_counter::probe probe("forecast::on_update");
+        watchdog::scope timer("forecast::on_update");
+
+        float now = gametime->get_time();
+
+        for (auto& ally : allies)
+            ally.damage.fill(0.0f);
+
+        for (auto& t : threats)
+        {
+            if (!t.active)
+                continue;
+            if (now > t.expire_time)
+            {
+                t.active = false;
+                continue;
+            }
+
+            for (auto& ally : allies)
+            {
+                if (t.shape == threat_shape::targeted && t.target_id != ally.id)
+                    continue;
+                if (!ally.hero->is_valid() || ally.hero->is_dead())
+                    continue;
+
+                float hit_in = time_to_hit(t, ally.hero->get_position(), ally.hero->get_bounding_radius(), now);
+                if (hit_in < 0.0f || hit_in > HORIZONS[HORIZON_COUNT - 1])
+                    continue;
+
+                float damage = estimate_damage(t, ally.hero);
+                for (int i = 0; i < HORIZON_COUNT; ++i)
+                {
+                    if (hit_in <= HORIZONS[i])
+                        ally.damage[i] += damage;
+                }
+            }
+        }
+    }
+
+    void on_process_spell_cast(game_object_script sender, spell_instance_script spell)
+    {
+        if (!sender || !spell || !sender->is_enemy())
+            return;
+        if (!sender->is_ai_hero() && !sender->is_ai_turret())
+            return;
+
+        auto data = spell->get_spell_data();
+        float now = gametime->get_time();
+        auto& t = push_threat();
+        t.active = true;
+        t.sender = utils::make_handle(sender);
+        t.sender_id = sender->get_id();
+        t.slot = spell->get_spellslot();
+        t.is_auto_attack = spell->is_auto_attack();
+        t.target_id = spell->get_last_target_id();
+        t.speed = data ? data->mMissileSpeed : 0.0f;
+
+        auto start = spell->get_start_position();
+        auto end = spell->get_end_position();
+        t.start_x = start.x; t.start_y = start.y;
+        t.end_x = end.x; t.end_y = end.y;
+
+        float delay = t.is_auto_attack ? sender->get_attack_cast_delay() : DEFAULT_CAST_DELAY;
+        t.launch_time = now + delay;
+        t.expire_time = now + MAX_THREAT_LIFETIME;
+
+        if (t.target_id != 0)
+        {
+            t.shape = threat_shape::targeted;
+        }
+        else if (data && data->mLineWidth > 0.0f)
+        {
+            t.shape = threat_shape::line;
+            t.width = data->mLineWidth * 2.0f;
+        }
+        else
+        {
+            t.shape = threat_shape::circle;
+            t.width = DEFAULT_CIRCLE_RADIUS;
+        }
+    }
+
+    void on_create_object(game_object_script sender)
+    {
+        if (!sender || !sender->is_missile())
+            return;
+
+        auto sender_id = sender->missile_get_sender_id();
+        auto start = sender->missile_get_start_position();
+        auto end = sender->missile_get_end_position();
+
+        // Attach the missile to the newest matching cast so it is not counted twice
+        for (int i = 1; i <= MAX_THREATS; ++i)
+        {
+            auto& t = threats[(threat_head - i + MAX_THREATS) % MAX_THREATS];
+            if (!t.active || t.sender_id != sender_id || t.missile_id != 0)
+                continue;
+
+            t.missile_id = sender->get_id();
+            t.launch_time = gametime->get_time();
+            t.start_x = start.x; t.start_y = start.y;
+            if (t.shape == threat_shape::line)
+            {
+                t.end_x = end.x; t.end_y = end.y;
+            }
+            if (auto data = sender->get_missile_sdata())
+                t.speed = data->mMissileSpeed;
+            return;
+        }
+    }
+
+    void on_delete_object(game_object_script sender)
+    {
+        if (!sender || !sender->is_missile())
+            return;
+
+        auto id = sender->get_id();
+        for (auto& t : threats)
+        {
+            if (t.active && t.missile_id == id)
+                t.active = false;
+        }
+    }
+
+    void load()
+    {
+        threats.fill(threat{});
+        threat_head = 0;
+        allies.clear();
+        bool has_me = false;
+        for (auto& ally : entitylist->get_ally_heroes())
+        {
+            if (ally && ally->is_valid())
+            {
+                has_me = has_me || ally->is_me();
+                allies.push_back({ ally, ally->get_id() });
+            }
+        }
+        // Zed's lethal check reads our own forecast, keep it even if the ally list leaves us out
+        if (!has_me && myhero)
+            allies.push_back({ myhero, myhero->get_id() });
+
+        event_handler<events::on_update>::add_callback(on_update);
+        event_handler<events::on_process_spell_cast>::add_callback(on_process_spell_cast);
+        event_handler<events::on_create_object>::add_callback(on_create_object);
+        event_handler<events::on_delete_object>::add_callback(on_delete_object);
+    }
+
+    void unload()
+    {
+        event_handler<events::on_update>::remove_handler(on_update);
+        event_handler<events::on_process_spell_cast>::remove_handler(on_process_spell_cast);
+        event_handler<events::on_create_object>::remove_handler(on_create_object);
+        event_handler<events::on_delete_object>::remove_handler(on_delete_object);
+        allies.clear();
+    }
+
+    float get_incoming_damage(game_object_script ally, float seconds)
+    {
+        if (!ally)
+            return 0.0f;
+
+        int horizon = 0;
+        while (horizon < HORIZON_COUNT - 1 && seconds > HORIZONS[horizon])
+            ++horizon;
+
+        auto id = ally->get_id();
+        for (const auto& entry : allies)
+        {
+            if (entry.id == id)
+                return entry.damage[horizon];
+        }
+        return 0.0f;
+    }
+
+    bool has_incoming_spell(game_object_script ally, spellslot slot, float seconds, bool (*filter)(const game_object_script& sender))
+    {
+        if (!ally || !ally->is_valid())
+            return false;
+
+        float now = gametime->get_time();
+        auto id = ally->get_id();
+        auto pos = ally->get_position();
+        float bounding = ally->get_bounding_radius();
+        for (const auto& t : threats)
+        {
+            if (!t.active || t.slot != slot || now > t.expire_time)
+                continue;
+            if (t.shape == threat_shape::targeted && t.target_id != id)
+                continue;
+            auto sender = utils::resolve(t.sender);
+            if (!sender || !sender->is_valid() || (filter && !filter(sender)))
+                continue;
+
+            float hit_in = time_to_hit(t, pos, bounding, now);
+            if (hit_in >= 0.0f && hit_in <= seconds)
+                return true;
+        }
+        return false;
+    }
+}
@@ -0,0 +1,21 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+
+#pragma once
+namespace forecast
+{
+    // Forecast horizons in seconds
+    constexpr int HORIZON_COUNT = 3;
+    constexpr float HORIZONS[HORIZON_COUNT] = { 0.25f, 0.5f, 1.0f };
+
+    // Tracker lifetime
+    //
+    void load();
+    void unload();
+
+    // Queries
+    //
+    // Damage the ally is expected to take within `seconds` (rounded up to the next horizon)
+    float get_incoming_damage(game_object_script ally, float seconds);
+    // True when a tracked `slot` cast from a sender accepted by `filter` reaches the ally within `seconds`
+    bool has_incoming_spell(game_object_script ally, spellslot slot, float seconds, bool (*filter)(const game_object_script& sender));
+};
@@ -0,0 +1,132 @@
+#include "hero_table.h"
+#include "../plugin_sdk/plugin_sdk.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace hero_table
+{
+    // Network ids are sparse, so the slot map is a short id array scanned linearly; it fits in one cache line
+    static std::array<std::uint32_t, MAX_HEROES> ids = {};
+    static std::array<game_object_script, MAX_HEROES> heroes = {};
+    static int count = 0;
+
+    static std::vector<column*> columns;
+
+    void add_hero(const game_object_script& hero)
+    {
+        if (!hero || !hero->is_valid() || count >= MAX_HEROES)
+            return;
+        auto id = hero->get_network_id();
+        if (slot_of(id) >= 0)
+            return;
+        ids[count] = id;
+        heroes[count] = hero;
+        ++count;
+    }
+
+    int slot_of(std::uint32_t network_id)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            if (ids[i] == network_id)
+                return i;
+        }
+        return -1;
+    }
+
+    int slot_of(const game_object_script& unit)
+    {
+        return unit ? slot_of(unit->get_network_id()) : -1;
+    }
+
+    game_object_script hero_at(int slot)
+    {
+        return slot >= 0 && slot < count ? heroes[slot] : nullptr;
+    }
+
+    int hero_count()
+    {
+        return count;
+    }
+
+    void refresh(column& value)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            if (auto entry = value.entries[i])
+            {
+                value.enabled[i] = entry->get_bool();
+                value.value[i] = entry->get_int();
+            }
+        }
+
+        if (!value.priority_list)
+            return;
+
+        value.order_count = 0;
+        for (int i = 0; i < count; ++i)
+        {
+            auto pr = value.priority_list->get_prority(ids[i]);
+            value.value[i] = pr.first;
+            value.enabled[i] = pr.first != -1 && pr.second;
+            if (value.enabled[i])
+                value.order[value.order_count++] = i;
+        }
+        std::stable_sort(value.order.begin(), value.order.begin() + value.order_count, [&value](int a, int b) {
+            return value.value[a] < value.value[b];
+        });
+    }
+
+    // One callback for every bound entry; a handful of heroes per column makes a full refresh cheaper than finding the owner
+    void on_entry_change(TreeEntry*)
+    {
+        for (auto c : columns)
+            refresh(*c);
+    }
+
+    void add_column(column* value)
+    {
+        if (value && std::find(columns.begin(), columns.end(), value) == columns.end())
+            columns.push_back(value);
+    }
+
+    void remove_column(column* value)
+    {
+        columns.erase(std::remove(columns.begin(), columns.end(), value), columns.end());
+    }
+
+    void bind_entry(column& value, const game_object_script& hero, TreeEntry* entry)
+    {
+        int slot = slot_of(hero);
+        if (slot < 0 || !entry)
+            return;
+        value.entries[slot] = entry;
+        entry->add_property_change_callback(on_entry_change);
+        refresh(value);
+    }
+
+    void bind_priority_list(column& value, TreeEntry* list)
+    {
+        value.priority_list = list;
+        if (list)
+            list->add_property_change_callback(on_entry_change);
+        refresh(value);
+    }
+
+    void load()
+    {
+        count = 0;
+        add_hero(myhero);
+        for (auto& ally : entitylist->get_ally_heroes())
+            add_hero(ally);
+        for (auto& enemy : entitylist->get_enemy_heroes())
+            add_hero(enemy);
+    }
+
+    void unload()
+    {
+        columns.clear();
+        heroes.fill(nullptr);
+        count = 0;
+    }
+}
@@ -0,0 +1,58 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+#include <array>
+
+#pragma once
+namespace hero_table
+{
+    // Both teams plus spare room for swapped/rejoining heroes
+    constexpr int MAX_HEROES = 12;
+
+    // Per-hero menu values, one dense slot per hero
+    //
+    // Bound entries and priority lists are copied in at bind time and again from the menu change
+    // callback, so lookups in the tick are a plain array read instead of a map or a get_prority call.
+    struct column
+    {
+        std::array<TreeEntry*, MAX_HEROES> entries = {};
+        TreeEntry* priority_list = nullptr;
+
+        std::array<bool, MAX_HEROES> enabled = {};
+        std::array<int, MAX_HEROES> value = {};
+        // Slots sorted by priority, only enabled entries, filled when a priority list is bound
+        std::array<int, MAX_HEROES> order = {};
+        int order_count = 0;
+    };
+
+    // Slot map, built once at load
+    //
+    void load();
+    void unload();
+
+    // -1 for units that are not heroes of this game
+    int slot_of(std::uint32_t network_id);
+    int slot_of(const game_object_script& unit);
+    game_object_script hero_at(int slot);
+    int hero_count();
+
+    // Columns
+    //
+    // Columns stay registered for change callbacks until removed, remove them before their menu is deleted
+    void add_column(column* value);
+    void remove_column(column* value);
+    void bind_entry(column& value, const game_object_script& hero, TreeEntry* entry);
+    void bind_priority_list(column& value, TreeEntry* list);
+    void refresh(column& value);
+
+    // `fallback` for units without a slot or without a bound entry
+    inline bool get_bool(const column& value, const game_object_script& unit, bool fallback)
+    {
+        int slot = slot_of(unit);
+        return slot >= 0 && (value.entries[slot] || value.priority_list) ? value.enabled[slot] : fallback;
+    }
+
+    inline int get_int(const column& value, const game_object_script& unit, int fallback)
+    {
+        int slot = slot_of(unit);
+        return slot >= 0 && (value.entries[slot] || value.priority_list) ? value.value[slot] : fallback;
+    }
+};
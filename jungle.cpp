@@ -0,0 +1,245 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+#include "jungle.h"
+#include <cstring>
+
+namespace jungle
+{
+    // Summoner's Rift camp centers (ground x/y), respawn times in seconds and big monster models
+    struct camp_info
+    {
+        const char* name;
+        float x;
+        float y;
+        float respawn;
+        const char* big_model;
+    };
+
+    static constexpr camp_info CAMP_INFO[] =
+    {
+        { "Blue Blue Buff", 3872.0f, 7900.0f, 300.0f, "SRU_Blue" },
+        { "Blue Gromp", 2091.0f, 8428.0f, 135.0f, "SRU_Gromp" },
+        { "Blue Wolves", 3783.0f, 6495.0f, 135.0f, "SRU_Murkwolf" },
+        { "Blue Raptors", 7061.0f, 5325.0f, 135.0f, "SRU_Razorbeak" },
+        { "Blue Red Buff", 7862.0f, 4111.0f, 300.0f, "SRU_Red" },
+        { "Blue Krugs", 8394.0f, 2641.0f, 135.0f, "SRU_Krug" },
+        { "Red Blue Buff", 10931.0f, 6990.0f, 300.0f, "SRU_Blue" },
+        { "Red Gromp", 12703.0f, 6443.0f, 135.0f, "SRU_Gromp" },
+        { "Red Wolves", 11008.0f, 8387.0f, 135.0f, "SRU_Murkwolf" },
+        { "Red Raptors", 7762.0f, 9667.0f, 135.0f, "SRU_Razorbeak" },
+        { "Red Red Buff", 7017.0f, 10775.0f, 300.0f, "SRU_Red" },
+        { "Red Krugs", 6317.0f, 12146.0f, 135.0f, "SRU_Krug" },
+        { "Bot Scuttle", 10500.0f, 5170.0f, 150.0f, "Sru_Crab" },
+        { "Top Scuttle", 4400.0f, 9600.0f, 150.0f, "Sru_Crab" },
+        { "Dragon", 9866.0f, 4414.0f, 300.0f, "SRU_Dragon" },
+        { "Baron", 5007.0f, 10471.0f, 360.0f, "SRU_Baron" },
+    };
+    constexpr int CAMP_COUNT = static_cast<int>(sizeof(CAMP_INFO) / sizeof(CAMP_INFO[0]));
+
+    static camp camps[CAMP_COUNT];
+
+    static void reset_camp(camp& c, const camp_info& info)
+    {
+        c = camp{};
+        c.name = info.name;
+        c.x = info.x;
+        c.y = info.y;
+        c.respawn = info.respawn;
+        c.big_model = info.big_model;
+    }
+
+    // Cleared and not back yet, checked before touching any handle
+    static bool is_respawning(const camp& c, float now)
+    {
+        return c.respawn_at > now;
+    }
+
+    static bool is_alive(const game_object_script& monster)
+    {
+        return monster && monster->is_valid() && !monster->is_dead();
+    }
+
+    static camp* find_camp(const vector& pos)
+    {
+        camp* best = nullptr;
+        float best_distance = CAMP_RADIUS * CAMP_RADIUS;
+        for (auto& c : camps)
+        {
+            float dx = pos.x - c.x, dy = pos.y - c.y;
+            float distance = dx * dx + dy * dy;
+            if (distance < best_distance)
+            {
+                best_distance = distance;
+                best = &c;
+            }
+        }
+        return best;
+    }
+
+    // Max health is not reliable on the create event yet, the model name is. "SRU_MurkwolfMini" and
+    // "SRU_KrugMini" stay small, "SRU_Dragon_Fire" is big.
+    static bool is_big_model(const camp& c, const char* model)
+    {
+        if (!c.big_model || !model)
+            return false;
+        auto length = std::strlen(c.big_model);
+        return std::strncmp(model, c.big_model, length) == 0 && (model[length] == '\0' || model[length] == '_');
+    }
+
+    static void add_monster(game_object_script monster)
+    {
+        auto c = find_camp(monster->get_position());
+        if (!c)
+            return;
+        auto handle = utils::make_handle(monster);
+        if (!handle.is_set())
+            return;
+
+        c->respawn_at = 0.0f;
+        if (is_big_model(*c, monster->get_model_cstr()) && !utils::resolve(c->big))
+            c->big = handle;
+        else if (c->small_count < MAX_CAMP_MONSTERS)
+            c->smalls[c->small_count++] = handle;
+    }
+
+    // The handle table may already have recycled the deleted monster's slot, so an entry goes when it
+    // matches the network id or no longer resolves at all
+    static bool is_gone(const utils::entity_handle& handle, std::uint32_t id)
+    {
+        auto object = utils::resolve(handle);
+        return !object || object->get_network_id() == id;
+    }
+
+    // No promotion once the big monster dies: get_main_monster picks among the smalls when asked,
+    // by then their health is settled (krug splits spawn small)
+    static void remove_monster(game_object_script monster)
+    {
+        auto id = monster->get_network_id();
+        for (auto& c : camps)
+        {
+            bool found = false;
+            if (c.big.is_set() && is_gone(c.big, id))
+            {
+                c.big = {};
+                found = true;
+            }
+            for (int i = 0; i < c.small_count;)
+            {
+                if (!is_gone(c.smalls[i], id))
+                {
+                    ++i;
+                    continue;
+                }
+                c.smalls[i] = c.smalls[--c.small_count];
+                c.smalls[c.small_count] = {};
+                found = true;
+            }
+
+            if (found && !c.big.is_set() && c.small_count == 0)
+                c.respawn_at = gametime->get_time() + c.respawn;
+        }
+    }
+
+    void on_create_object(game_object_script sender)
+    {
+        if (sender && sender->is_valid() && sender->is_monster() && !sender->is_ward())
+            add_monster(sender);
+    }
+
+    void on_delete_object(game_object_script sender)
+    {
+        if (sender && sender->is_monster())
+            remove_monster(sender);
+    }
+
+    void load()
+    {
+        for (int i = 0; i < CAMP_COUNT; ++i)
+            reset_camp(camps[i], CAMP_INFO[i]);
+
+        // Monsters already on the map when the plugin loads
+        for (auto& mob : entitylist->get_jugnle_mobs_minions())
+        {
+            if (is_alive(mob) && !mob->is_ward())
+                add_monster(mob);
+        }
+
+        event_handler<events::on_create_object>::add_callback(on_create_object);
+        event_handler<events::on_delete_object>::add_callback(on_delete_object);
+    }
+
+    void unload()
+    {
+        event_handler<events::on_create_object>::remove_handler(on_create_object);
+        event_handler<events::on_delete_object>::remove_handler(on_delete_object);
+        for (int i = 0; i < CAMP_COUNT; ++i)
+            reset_camp(camps[i], CAMP_INFO[i]);
+    }
+
+    const camp* get_camp_in_range(const vector& pos, float range)
+    {
+        const camp* best = nullptr;
+        float best_distance = range * range;
+        float now = gametime->get_time();
+        for (const auto& c : camps)
+        {
+            if (is_respawning(c, now) || (!c.big.is_set() && c.small_count == 0))
+                continue;
+
+            // Camp center can be farther than range while a monster is inside it
+            auto check = [&](const utils::entity_handle& handle)
+            {
+                auto monster = utils::resolve(handle);
+                if (!is_alive(monster))
+                    return;
+                float distance = monster->get_position().distance_squared(pos);
+                if (distance <= best_distance)
+                {
+                    best_distance = distance;
+                    best = &c;
+                }
+            };
+            check(c.big);
+            for (int i = 0; i < c.small_count; ++i)
+                check(c.smalls[i]);
+        }
+        return best;
+    }
+
+    game_object_script get_main_monster(const camp* value)
+    {
+        if (!value)
+            return nullptr;
+        auto big = utils::resolve(value->big);
+        if (is_alive(big))
+            return big;
+
+        game_object_script best = nullptr;
+        for (int i = 0; i < value->small_count; ++i)
+        {
+            auto small = utils::resolve(value->smalls[i]);
+            if (is_alive(small) && (!best || small->get_health() > best->get_health()))
+                best = small;
+        }
+        return best;
+    }
+
+    game_object_script get_biggest_monster(const camp* value, const vector& from, float range, float min_health)
+    {
+        if (!value)
+            return nullptr;
+
+        game_object_script best = nullptr;
+        auto consider = [&](const utils::entity_handle& handle)
+        {
+            auto monster = utils::resolve(handle);
+            if (!is_alive(monster) || !monster->is_valid_target(range, from) || monster->get_health() < min_health)
+                return;
+            if (!best || monster->get_max_health() > best->get_max_health())
+                best = monster;
+        };
+        consider(value->big);
+        for (int i = 0; i < value->small_count; ++i)
+            consider(value->smalls[i]);
+        return best;
+    }
+}
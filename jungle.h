@@ -0,0 +1,43 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+#include "utils.h"
+
+#pragma once
+namespace jungle
+{
+    constexpr int MAX_CAMP_MONSTERS = 8;
+    // Monsters farther than this from every camp center (roamed or leashed far) are ignored
+    constexpr float CAMP_RADIUS = 800.0f;
+
+    struct camp
+    {
+        const char* name = nullptr;
+        float x = 0.0f;
+        float y = 0.0f;
+        float respawn = 0.0f;
+        // Model of the big monster, variants with a "_" suffix (dragons) match too
+        const char* big_model = nullptr;
+
+        // Monster with the big model is the big one, the rest are small
+        utils::entity_handle big;
+        utils::entity_handle smalls[MAX_CAMP_MONSTERS];
+        int small_count = 0;
+
+        // Time the camp comes back, 0 while it is up or before it was ever cleared
+        float respawn_at = 0.0f;
+    };
+
+    // Model lifetime, fed by object create/delete events
+    //
+    void load();
+    void unload();
+
+    // Queries
+    //
+    // Closest camp with a living monster within `range` of `pos`, nullptr if none. Camps waiting on
+    // their respawn timer are skipped without resolving any monster.
+    const camp* get_camp_in_range(const vector& pos, float range);
+    // Living big monster, or the healthiest living small one once the big one is gone
+    game_object_script get_main_monster(const camp* value);
+    // Highest max health living monster of the camp within `range` of `from` with at least `min_health`
+    game_object_script get_biggest_monster(const camp* value, const vector& from, float range, float min_health);
+};
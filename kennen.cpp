@@ -2,20 +2,30 @@
 #include "../plugin_sdk/plugin_sdk.hpp"
 #include <string>
 #include "utils.h"
+#include "alloc_counter.h"
+#include "turrets.h"
+#include "minion_health.h"
+#include "parallel.h"
+#include "spell_data.h"
+#include "movement.h"
+#include "waves.h"
+#include "hero_table.h"
+#include "watchdog.h"
 #include "permashow.hpp"
 #include <algorithm>
 #include <vector>
+#include <array>
+#include <cstring>
+#include <xmmintrin.h>
 
 namespace kennen
 {
-    constexpr float Q_RANGE_DEFAULT = 1050.0f;
-    constexpr float Q_SPEED = 1700.0f;
-    constexpr float Q_WIDTH = 70.0f;
-    constexpr float Q_DELAY = 0.175f;
-    constexpr float W_RANGE = 750.0f;
-    constexpr float R_RANGE = 550.0f;
-    constexpr float Q_FARM_RADIUS = 140.0f;
-    constexpr float E_RANGE = 750.0f;
+    constexpr float Q_RANGE_DEFAULT = spell_data::kennen::Q.range;
+    constexpr float W_RANGE = spell_data::kennen::W.range;
+    constexpr float R_RANGE = spell_data::kennen::R.aoe_radius;
+    constexpr float Q_FARM_RADIUS = spell_data::kennen::Q.aoe_radius;
+    constexpr float E_RANGE = spell_data::kennen::E.range;
+    constexpr float FARM_KILL_WEIGHT = 1.0f;
 
     static script_spell* q = nullptr;
     static script_spell* w = nullptr;
@@ -64,74 +74,89 @@ namespace kennen
 
     hit_chance get_hitchance_by_config(TreeEntry* hit)
     {
+        hit_chance value = hit_chance::high;
         switch (hit ? hit->get_int() : 2)
         {
-            case 0: return hit_chance::low;
-            case 1: return hit_chance::medium;
-            case 2: return hit_chance::high;
-            case 3: return hit_chance::very_high;
-            default: return hit_chance::high;
+            case 0: value = hit_chance::low; break;
+            case 1: value = hit_chance::medium; break;
+            case 3: value = hit_chance::very_high; break;
+            default: break;
         }
+        // Capped while the watchdog sheds work
+        return watchdog::clamp_hitchance(value);
     }
 
-    bool has_three_stacks(const game_object_script& obj)
+    bool is_mark_buff(const buff_instance_script& buff)
     {
-        if (!obj || !obj->is_valid()) return false;
-        for (const auto& buff : obj->get_bufflist())
-        {
-            if (buff && buff->is_valid())
-            {
-                std::string name = buff->get_name();
-                if (name.find("kennenmarkofstorm") != std::string::npos && buff->get_count() >= 3)
-                    return true;
-            }
-        }
-        return false;
+        if (!buff || !buff->is_valid()) return false;
+        auto name = buff->get_name_cstr();
+        return name && std::strstr(name, "kennenmarkofstorm");
     }
 
-    bool has_two_stacks(const game_object_script& obj)
+    buff_instance_script find_mark_buff(const game_object_script& obj)
     {
-        if (!obj || !obj->is_valid()) return false;
         for (const auto& buff : obj->get_bufflist())
         {
-            if (buff && buff->is_valid())
-            {
-                std::string name = buff->get_name();
-                if (name.find("kennenmarkofstorm") != std::string::npos && buff->get_count() == 2)
-                    return true;
-            }
+            if (is_mark_buff(buff))
+                return buff;
         }
-        return false;
+        return nullptr;
     }
 
-    bool has_any_stacks(const game_object_script& obj)
+    // --- MARK TRACKER ---
+    // Mark of Storm on heroes, kept per hero slot from buff events so the stun evaluator and the
+    // combo never walk hero bufflists. Minions still use the bufflist scan.
+    static std::array<buff_instance_script, hero_table::MAX_HEROES> hero_marks;
+
+    void on_buff_gain(game_object_script sender, buff_instance_script buff)
     {
-        if (!obj || !obj->is_valid()) return false;
-        for (const auto& buff : obj->get_bufflist())
+        if (!sender || !sender->is_ai_hero() || !is_mark_buff(buff)) return;
+        int slot = hero_table::slot_of(sender);
+        if (slot >= 0)
+            hero_marks[slot] = buff;
+    }
+
+    void on_buff_lose(game_object_script sender, buff_instance_script buff)
+    {
+        if (!sender || !sender->is_ai_hero() || !is_mark_buff(buff)) return;
+        int slot = hero_table::slot_of(sender);
+        if (slot >= 0)
+            hero_marks[slot] = nullptr;
+    }
+
+    // Marks already on heroes when the plugin loads mid-game
+    void seed_hero_marks()
+    {
+        hero_marks.fill(nullptr);
+        for (int slot = 0; slot < hero_table::hero_count(); ++slot)
         {
-            if (buff && buff->is_valid())
-            {
-                std::string name = buff->get_name();
-                if (name.find("kennenmarkofstorm") != std::string::npos && buff->get_count() >= 1)
-                    return true;
-            }
+            auto hero = hero_table::hero_at(slot);
+            if (hero && hero->is_valid())
+                hero_marks[slot] = find_mark_buff(hero);
         }
-        return false;
     }
 
     int get_kennen_stack_count(const game_object_script& obj)
     {
         if (!obj || !obj->is_valid()) return 0;
-        for (const auto& buff : obj->get_bufflist())
-        {
-            if (buff && buff->is_valid())
-            {
-                std::string name = buff->get_name();
-                if (name.find("kennenmarkofstorm") != std::string::npos)
-                    return buff->get_count();
-            }
-        }
-        return 0;
+        int slot = obj->is_ai_hero() ? hero_table::slot_of(obj) : -1;
+        auto buff = slot >= 0 ? hero_marks[slot] : find_mark_buff(obj);
+        return buff && buff->is_valid() ? buff->get_count() : 0;
+    }
+
+    bool has_three_stacks(const game_object_script& obj)
+    {
+        return get_kennen_stack_count(obj) >= 3;
+    }
+
+    bool has_two_stacks(const game_object_script& obj)
+    {
+        return get_kennen_stack_count(obj) == 2;
+    }
+
+    bool has_any_stacks(const game_object_script& obj)
+    {
+        return get_kennen_stack_count(obj) >= 1;
     }
 
     bool kennen_w_passive_ready()
@@ -151,13 +176,19 @@ namespace kennen
 
     bool is_near_enemy_turret()
     {
-        for (auto& turret : entitylist->get_enemy_turrets())
-        {
-            if (turret && turret->is_valid() && !turret->is_dead() &&
-                turret->get_distance(myhero) < 900.0f)
-                return true;
-        }
-        return false;
+        return turrets::is_in_enemy_range(myhero->get_position(), 900.0f);
+    }
+
+    // Cheap minion collision precheck so blocked casts skip SDK prediction
+    bool q_path_blocked(const game_object_script& target)
+    {
+        return utils::find_blocking_minion(myhero->get_position(), target->get_position(), spell_data::kennen::Q.width, target) != nullptr;
+    }
+
+    // Tracked-path intercept, skips the SDK prediction for targets that will walk out of Q range
+    bool q_in_reach(const game_object_script& target)
+    {
+        return movement::can_reach(target, myhero->get_position(), spell_data::kennen::Q);
     }
 
     static int kennen_stacks = 0;
@@ -174,33 +205,9 @@ namespace kennen
     void kennen_cast_q()
     {
         auto target = target_selector->get_target(Q_RANGE_DEFAULT, damage_type::magical);
-        if (target && target->is_valid() && !target->is_dead() && target->is_visible())
+        if (target && target->is_valid() && !target->is_dead() && target->is_visible() && q_in_reach(target) && !q_path_blocked(target))
         {
-            q->cast(target, get_hitchance_by_config(settings::q_hitchance));
-        }
-    }
-
-    void kennen_auto_w()
-    {
-        if (!w || !w->is_ready()) return;
-        for (auto& enemy : entitylist->get_enemy_heroes())
-        {
-            if (enemy && enemy->is_valid() && !enemy->is_dead() && enemy->is_visible() && myhero->get_distance(enemy) < W_RANGE)
-            {
-                if (settings::auto_w_3stacks && settings::auto_w_3stacks->get_bool())
-                {
-                    if (has_three_stacks(enemy))
-                    {
-                        w->cast();
-                        return;
-                    }
-                }
-                else if (has_two_stacks(enemy))
-                {
-                    w->cast();
-                    return;
-                }
-            }
+            utils::cast(q, target, get_hitchance_by_config(settings::q_hitchance));
         }
     }
 
@@ -210,7 +217,7 @@ namespace kennen
 
         if (settings::use_e_flee && settings::use_e_flee->get_bool() && orbwalker->flee_mode())
         {
-            e->cast();
+            utils::cast(e);
             return;
         }
 
@@ -218,7 +225,7 @@ namespace kennen
             settings::use_e_tower_hotkey && settings::use_e_tower_hotkey->get_bool() &&
             is_near_enemy_turret())
         {
-            e->cast();
+            utils::cast(e);
             return;
         }
 
@@ -231,31 +238,202 @@ namespace kennen
                     int stacks = get_kennen_stack_count(enemy);
                     if (stacks == 2)
                     {
-                        e->cast();
+                        utils::cast(e);
                         return;
                     }
-                    e->cast();
+                    utils::cast(e);
                     return;
                 }
             }
         }
     }
 
-    void kennen_r_logic()
+    // --- STUN WINDOW EVALUATOR ---
+    // Counts how many enemies each action (W now, R now, E in then R) would stun, from their current
+    // mark stacks and positions extrapolated along their path over the storm duration. The R slider keeps
+    // its meaning (enemies in range); predicted stuns only decide between the actions.
+    constexpr int MAX_STUN_ENEMIES = 8;
+    constexpr float R_DURATION = 3.0f;
+    constexpr float R_HIT_INTERVAL = 0.5f;
+    // Lightning Rush: bonus move speed while it lasts, Kennen walks toward the enemies during it
+    constexpr float E_DURATION = 2.0f;
+    constexpr float E_BONUS_MOVE_SPEED = 1.0f;
+
+    // SoA enemy state, padded lanes stay out of every range test
+    struct stun_enemies
     {
-        if (!r || !r->is_ready() || !myhero || myhero->is_dead()) return;
-        if (!settings::use_r || !settings::use_r->get_bool()) return;
-
-        int min_enemies = settings::r_enemy_slider ? settings::r_enemy_slider->get_int() : 3;
+        alignas(16) float x[MAX_STUN_ENEMIES];
+        alignas(16) float y[MAX_STUN_ENEMIES];
+        alignas(16) float vx[MAX_STUN_ENEMIES];
+        alignas(16) float vy[MAX_STUN_ENEMIES];
+        alignas(16) float stacks[MAX_STUN_ENEMIES];
         int count = 0;
+    };
+
+    enum class stun_action
+    {
+        none,
+        w_now,
+        r_now,
+        e_then_r
+    };
+
+    static float e_then_r_until = 0.0f;
+
+    void build_stun_enemies(stun_enemies& out)
+    {
+        out.count = 0;
+        for (int i = 0; i < MAX_STUN_ENEMIES; ++i)
+        {
+            out.x[i] = out.y[i] = 1.0e9f;
+            out.vx[i] = out.vy[i] = out.stacks[i] = 0.0f;
+        }
+
         for (auto& enemy : entitylist->get_enemy_heroes())
         {
-            if (enemy && enemy->is_valid() && !enemy->is_dead() && enemy->is_visible() && myhero->get_distance(enemy) < R_RANGE)
-                count++;
+            if (out.count == MAX_STUN_ENEMIES) break;
+            if (!enemy || !enemy->is_valid() || enemy->is_dead() || !enemy->is_visible()) continue;
+
+            auto pos = enemy->get_position();
+            vector velocity;
+            if (enemy->is_moving())
+                velocity = enemy->get_pathing_direction().normalized() * enemy->get_move_speed();
+
+            int i = out.count++;
+            out.x[i] = pos.x;
+            out.y[i] = pos.y;
+            out.vx[i] = velocity.x;
+            out.vy[i] = velocity.y;
+            out.stacks[i] = static_cast<float>(get_kennen_stack_count(enemy));
+        }
+    }
+
+    // Enemies within `range` of (cx, cy) after `delay` holding at least `min_stacks` marks
+    int count_marked_in_range(const stun_enemies& en, float cx, float cy, float range, float min_stacks, float delay = 0.0f)
+    {
+        const __m128 vcx = _mm_set1_ps(cx), vcy = _mm_set1_ps(cy), vt = _mm_set1_ps(delay);
+        const __m128 range_sq = _mm_set1_ps(range * range), need = _mm_set1_ps(min_stacks);
+        int stunned = 0;
+        for (int i = 0; i < MAX_STUN_ENEMIES; i += 4)
+        {
+            __m128 dx = _mm_sub_ps(_mm_add_ps(_mm_load_ps(&en.x[i]), _mm_mul_ps(_mm_load_ps(&en.vx[i]), vt)), vcx);
+            __m128 dy = _mm_sub_ps(_mm_add_ps(_mm_load_ps(&en.y[i]), _mm_mul_ps(_mm_load_ps(&en.vy[i]), vt)), vcy);
+            __m128 in_range = _mm_cmplt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), range_sq);
+            __m128 ready = _mm_cmpge_ps(_mm_load_ps(&en.stacks[i]), need);
+            int mask = _mm_movemask_ps(_mm_and_ps(in_range, ready));
+            for (; mask; mask &= mask - 1) ++stunned;
+        }
+        return stunned;
+    }
+
+    // Storm centered on (cx, cy) starting after `delay`: every hit adds a mark, three marks stun
+    int count_r_stuns(const stun_enemies& en, float cx, float cy, float delay)
+    {
+        const __m128 vcx = _mm_set1_ps(cx), vcy = _mm_set1_ps(cy);
+        const __m128 radius_sq = _mm_set1_ps(R_RANGE * R_RANGE), one = _mm_set1_ps(1.0f), three = _mm_set1_ps(3.0f);
+        int stunned = 0;
+        for (int i = 0; i < MAX_STUN_ENEMIES; i += 4)
+        {
+            __m128 x = _mm_load_ps(&en.x[i]), y = _mm_load_ps(&en.y[i]);
+            __m128 vx = _mm_load_ps(&en.vx[i]), vy = _mm_load_ps(&en.vy[i]);
+            __m128 marks = _mm_load_ps(&en.stacks[i]);
+            for (float t = 0.0f; t <= R_DURATION; t += R_HIT_INTERVAL)
+            {
+                __m128 vt = _mm_set1_ps(delay + t);
+                __m128 dx = _mm_sub_ps(_mm_add_ps(x, _mm_mul_ps(vx, vt)), vcx);
+                __m128 dy = _mm_sub_ps(_mm_add_ps(y, _mm_mul_ps(vy, vt)), vcy);
+                __m128 hit = _mm_cmplt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), radius_sq);
+                marks = _mm_add_ps(marks, _mm_and_ps(hit, one));
+            }
+            int mask = _mm_movemask_ps(_mm_cmpge_ps(marks, three));
+            for (; mask; mask &= mask - 1) ++stunned;
+        }
+        return stunned;
+    }
+
+    void kennen_stun_logic()
+    {
+        if (!myhero || myhero->is_dead()) return;
+
+        bool can_w = settings::use_w && settings::use_w->get_bool() && w && w->is_ready();
+        bool can_r = settings::use_r && settings::use_r->get_bool() && r && r->is_ready();
+        bool can_e = can_r && settings::use_e_combo && settings::use_e_combo->get_bool() && e && e->is_ready();
+        if (!can_w && !can_r) return;
+
+        stun_enemies enemies;
+        build_stun_enemies(enemies);
+        if (enemies.count == 0) return;
+
+        auto pos = myhero->get_position();
+        int min_enemies = settings::r_enemy_slider ? settings::r_enemy_slider->get_int() : 3;
+        float w_stacks = settings::auto_w_3stacks && settings::auto_w_3stacks->get_bool() ? 3.0f : 2.0f;
+
+        // W only needs one stun to be worth it; R needs the menu minimum of enemies inside the storm
+        stun_action best = stun_action::none;
+        int best_stuns = 0;
+        float e_travel = 0.0f;
+        if (can_w)
+        {
+            int stuns = count_marked_in_range(enemies, pos.x, pos.y, W_RANGE, w_stacks);
+            if (stuns > best_stuns)
+            {
+                best = stun_action::w_now;
+                best_stuns = stuns;
+            }
+        }
+        if (can_r && count_marked_in_range(enemies, pos.x, pos.y, R_RANGE, 0.0f) >= min_enemies)
+        {
+            // Ties go to R, the storm keeps stunning after a W would be spent
+            int stuns = count_r_stuns(enemies, pos.x, pos.y, 0.0f);
+            if (best == stun_action::none || stuns >= best_stuns)
+            {
+                best = stun_action::r_now;
+                best_stuns = stuns;
+            }
         }
-        if (count >= min_enemies)
+        if (can_e && gametime->get_time() > e_then_r_until && myhero->get_move_speed() > 0.0f)
         {
-            r->cast();
+            // Rush toward the enemy centroid at E speed, stopping there or when E runs out, and storm from
+            // wherever that leaves us with the enemies extrapolated over the same time
+            float sx = 0.0f, sy = 0.0f;
+            for (int i = 0; i < enemies.count; ++i)
+            {
+                sx += enemies.x[i];
+                sy += enemies.y[i];
+            }
+            vector centroid(sx / enemies.count, sy / enemies.count);
+            float e_speed = myhero->get_move_speed() * (1.0f + E_BONUS_MOVE_SPEED);
+            float travel = std::min(pos.distance(centroid) / e_speed, E_DURATION);
+            vector engage = pos.extend(centroid, e_speed * travel);
+
+            // Only worth the E when it beats acting from here
+            if (count_marked_in_range(enemies, engage.x, engage.y, R_RANGE, 0.0f, travel) >= min_enemies)
+            {
+                int stuns = count_r_stuns(enemies, engage.x, engage.y, travel);
+                if (stuns > best_stuns)
+                {
+                    best = stun_action::e_then_r;
+                    best_stuns = stuns;
+                    e_travel = travel;
+                }
+            }
+        }
+
+        switch (best)
+        {
+            case stun_action::w_now:
+                utils::cast(w);
+                break;
+            case stun_action::r_now:
+                utils::cast(r);
+                break;
+            case stun_action::e_then_r:
+                // R follows on a later tick once the R-now evaluation agrees from the new position
+                if (utils::cast(e))
+                    e_then_r_until = gametime->get_time() + e_travel + R_HIT_INTERVAL;
+                break;
+            case stun_action::none:
+                break;
         }
     }
 
@@ -264,40 +442,67 @@ namespace kennen
         if (!settings::farm_q || !settings::farm_q->get_bool()) return;
         if (!q || !q->is_ready()) return;
         if (myhero->get_mana_percent() < (settings::farm_mana ? settings::farm_mana->get_int() : 40)) return;
-
-        auto minions = entitylist->get_enemy_minions();
-        if (minions.empty()) return;
+        if (!watchdog::should_run_farm()) return;
 
         float farm_range = settings::farm_q_range ? static_cast<float>(settings::farm_q_range->get_int()) : Q_RANGE_DEFAULT;
         int min_for_q = settings::farm_min_q ? settings::farm_min_q->get_int() : 3;
-        int best_count = 0;
-        vector best_position;
 
-        for (auto& m : minions)
+        // A Q circle stays inside one wave cluster, so clusters with fewer minions than the minimum are
+        // skipped without any per-minion prediction
+        auto hero_pos = myhero->get_position();
+        int cluster_count = 0;
+        auto clusters = waves::get_clusters(&cluster_count);
+        int member_total = 0;
+        for (int c = 0; c < cluster_count; ++c)
+            member_total += clusters[c].count;
+
+        // Forecast last hits once per minion so candidates are weighted by expected kills
+        utils::frame_vector<parallel::circle_point> units;
+        utils::frame_vector<parallel::circle_point> centers;
+        utils::frame_vector<vector> cast_positions;
+        units.reserve(member_total);
+        centers.reserve(member_total);
+        cast_positions.reserve(member_total);
+        for (int c = 0; c < cluster_count; ++c)
         {
-            if (!m || !m->is_valid() || m->is_dead() || m->get_distance(myhero) > farm_range)
+            const auto& wave = clusters[c];
+            if (wave.count < min_for_q || !waves::reaches(wave, hero_pos, farm_range + Q_FARM_RADIUS))
                 continue;
 
-            auto pred = q->get_prediction(m);
-            if (!pred._cast_position.is_valid()) continue;
-
-            int count = 0;
-            for (auto& n : minions)
+            auto members = waves::get_members(wave);
+            for (int i = 0; i < wave.count; ++i)
             {
+                auto& n = members[i];
                 if (!n || n->is_dead()) continue;
-                if (pred._cast_position.distance(n->get_position()) < Q_FARM_RADIUS)
-                    count++;
-            }
-            if (count > best_count)
-            {
-                best_count = count;
-                best_position = pred._cast_position;
+                auto pos = n->get_position();
+                float travel = spell_data::kennen::Q.delay + pos.distance(hero_pos) / spell_data::kennen::Q.speed;
+                units.push_back({ pos.x, pos.y, minion_health::is_killable(n, static_cast<float>(q->get_damage(n)), travel) });
+
+                // Prediction stays on the game thread, only the quadratic scoring below is parallel
+                if (!n->is_valid() || pos.distance(hero_pos) > farm_range) continue;
+                auto pred = q->get_prediction(n);
+                if (!pred._cast_position.is_valid()) continue;
+                centers.push_back({ pred._cast_position.x, pred._cast_position.y, false });
+                cast_positions.push_back(pred._cast_position);
             }
         }
 
-        if (best_count >= min_for_q && best_position.is_valid())
+        int candidate_count = static_cast<int>(centers.size());
+        utils::frame_vector<int> counts(candidate_count);
+        utils::frame_vector<float> scores(candidate_count);
+        parallel::score_circles(centers.data(), candidate_count, units.data(), static_cast<int>(units.size()),
+            Q_FARM_RADIUS, FARM_KILL_WEIGHT, counts.data(), scores.data());
+
+        // Kills only rank the candidates; the menu minimum is a plain minion count
+        int best = -1;
+        for (int i = 0; i < candidate_count; ++i)
         {
-            q->cast(best_position);
+            if (counts[i] >= min_for_q && (best < 0 || scores[i] > scores[best]))
+                best = i;
+        }
+        if (best >= 0)
+        {
+            utils::cast(q, cast_positions[best]);
         }
     }
 
@@ -306,8 +511,11 @@ namespace kennen
         if (!settings::farm_w || !settings::farm_w->get_bool()) return;
         if (!w || !w->is_ready()) return;
         if (myhero->get_mana_percent() < (settings::farm_mana ? settings::farm_mana->get_int() : 40)) return;
+        int min_for_w = settings::farm_min_q ? settings::farm_min_q->get_int() : 3;
+        // Mark lookups are string compares, skip them when the waves cannot hold enough minions
+        if (waves::count_in_range(myhero->get_position(), W_RANGE) < min_for_w) return;
 
-        auto minions = entitylist->get_enemy_minions();
+        auto& minions = entitylist->get_enemy_minions();
         int count = 0;
         for (auto& m : minions)
         {
@@ -327,8 +535,8 @@ namespace kennen
                 }
             }
         }
-        if (count >= (settings::farm_min_q ? settings::farm_min_q->get_int() : 3))
-            w->cast();
+        if (count >= min_for_w)
+            utils::cast(w);
     }
 
     void kennen_farm_e()
@@ -338,7 +546,8 @@ namespace kennen
         if (myhero->get_mana_percent() < (settings::farm_mana ? settings::farm_mana->get_int() : 40)) return;
 
         int min_for_e = settings::farm_min_q ? settings::farm_min_q->get_int() : 3;
-        auto minions = entitylist->get_enemy_minions();
+        if (waves::count_in_range(myhero->get_position(), 325.0f) < min_for_e) return;
+        auto& minions = entitylist->get_enemy_minions();
         int count = 0;
         for (auto& m : minions)
         {
@@ -347,7 +556,7 @@ namespace kennen
             count++;
         }
         if (count >= min_for_e)
-            e->cast();
+            utils::cast(e);
     }
 
     void kennen_harass()
@@ -358,8 +567,8 @@ namespace kennen
         if (settings::use_q_harass && settings::use_q_harass->get_bool() && q && q->is_ready())
         {
             auto target = target_selector->get_target(Q_RANGE_DEFAULT, damage_type::magical);
-            if (target && target->is_valid() && !target->is_dead() && target->is_visible())
-                q->cast(target, get_hitchance_by_config(settings::q_hitchance));
+            if (target && target->is_valid() && !target->is_dead() && target->is_visible() && q_in_reach(target) && !q_path_blocked(target))
+                utils::cast(q, target, get_hitchance_by_config(settings::q_hitchance));
         }
         if (settings::use_w_harass && settings::use_w_harass->get_bool() && w && w->is_ready())
         {
@@ -369,7 +578,7 @@ namespace kennen
                 {
                     if (has_two_stacks(enemy))
                     {
-                        w->cast();
+                        utils::cast(w);
                         break;
                     }
                 }
@@ -379,9 +588,9 @@ namespace kennen
         {
             for (auto& enemy : entitylist->get_enemy_heroes())
             {
-                if (enemy && enemy->is_valid() && !enemy->is_dead() && enemy->is_visible() && myhero->get_distance(enemy) < 700.0f)
+                if (enemy && enemy->is_valid() && !enemy->is_dead() && enemy->is_visible() && myhero->get_distance(enemy) < E_RANGE)
                 {
-                    e->cast();
+                    utils::cast(e);
                     break;
                 }
             }
@@ -400,9 +609,9 @@ namespace kennen
                 if (!enemy || !enemy->is_valid() || enemy->is_dead() || !enemy->is_visible()) continue;
                 if (myhero->get_distance(enemy) > Q_RANGE_DEFAULT) continue;
                 double dmg = q->get_damage(enemy);
-                if (dmg >= enemy->get_health())
+                if (dmg >= enemy->get_health() && !q_path_blocked(enemy))
                 {
-                    q->cast(enemy, hit_chance::medium);
+                    utils::cast(q, enemy, hit_chance::medium);
                     return;
                 }
             }
@@ -419,7 +628,7 @@ namespace kennen
                 double dmg = w->get_damage(enemy);
                 if (dmg >= enemy->get_health())
                 {
-                    w->cast();
+                    utils::cast(w);
                     return;
                 }
             }
@@ -435,7 +644,7 @@ namespace kennen
                 double dmg = e->get_damage(enemy);
                 if (dmg >= enemy->get_health())
                 {
-                    e->cast();
+                    utils::cast(e);
                     return;
                 }
             }
@@ -451,7 +660,7 @@ namespace kennen
                 double dmg = r->get_damage(enemy);
                 if (dmg >= enemy->get_health())
                 {
-                    r->cast();
+                    utils::cast(r);
                     return;
                 }
             }
@@ -460,6 +669,9 @@ namespace kennen
 
     void on_update()
     {
+        alloc_counter::probe probe("kennen::on_update");
+        watchdog::scope timer("kennen::on_update");
+
         if (!myhero || myhero->is_dead()) return;
 
         kennen_killsteal();
@@ -471,10 +683,7 @@ namespace kennen
             if (settings::use_q && settings::use_q->get_bool() && q && q->is_ready())
                 kennen_cast_q();
 
-            if (settings::use_w && settings::use_w->get_bool() && w && w->is_ready())
-                kennen_auto_w();
-
-            kennen_r_logic();
+            kennen_stun_logic();
         }
         else if (orbwalker->harass())
         {
@@ -490,7 +699,9 @@ namespace kennen
 
     void on_draw()
     {
-        if (!myhero) return;
+        watchdog::scope timer("kennen::on_draw");
+
+        if (!myhero || !watchdog::draw_range_circles()) return;
         auto pos = myhero->get_position();
 
         if (settings::draw_range_q && settings::draw_range_q->get_bool())
@@ -498,7 +709,7 @@ namespace kennen
         if (settings::draw_range_w && settings::draw_range_w->get_bool())
             draw_manager->add_circle(pos, W_RANGE, D3DCOLOR_ARGB(120, 255, 255, 0));
         if (settings::draw_range_e && settings::draw_range_e->get_bool())
-            draw_manager->add_circle(pos, 700.0f, D3DCOLOR_ARGB(120, 100, 255, 200));
+            draw_manager->add_circle(pos, E_RANGE, D3DCOLOR_ARGB(120, 100, 255, 200));
         if (settings::draw_range_r && settings::draw_range_r->get_bool())
             draw_manager->add_circle(pos, R_RANGE, D3DCOLOR_ARGB(120, 255, 50, 50));
 
@@ -511,19 +722,20 @@ namespace kennen
 
     void load()
     {
-        q = plugin_sdk->register_spell(spellslot::q, Q_RANGE_DEFAULT);
-        w = plugin_sdk->register_spell(spellslot::w, W_RANGE);
-        e = plugin_sdk->register_spell(spellslot::e, 0.0f);
-        r = plugin_sdk->register_spell(spellslot::r, R_RANGE);
+        q = spell_data::register_spell(spell_data::kennen::Q);
+        w = spell_data::register_spell(spell_data::kennen::W);
+        e = spell_data::register_spell(spell_data::kennen::E);
+        r = spell_data::register_spell(spell_data::kennen::R);
 
         if (!q || !w || !e || !r)
         {
             console->print("Kennen spell init failed!");
             return;
         }
-        q->set_skillshot(Q_DELAY, Q_WIDTH, Q_SPEED, { collisionable_objects::minions, collisionable_objects::heroes }, skillshot_type::skillshot_line);
 
         settings::main_tab = menu->create_tab("carry.kennen", "Kennen");
+        utils::on_load(settings::main_tab);
+
         auto main = settings::main_tab->add_tab("carry.kennen.main", "Main");
         // Combo
         settings::use_q = main->add_checkbox("carry.kennen.main.q", "Use Q (Combo)", true);
@@ -565,8 +777,11 @@ namespace kennen
         settings::ks_e = settings::ks_tab->add_checkbox("carry.kennen.ks.e", "Use E for Killsteal", true);
         settings::ks_r = settings::ks_tab->add_checkbox("carry.kennen.ks.r", "Use R for Killsteal", false);
 
+        seed_hero_marks();
         event_handler<events::on_update>::add_callback(on_update);
         event_handler<events::on_draw>::add_callback(on_draw);
+        event_handler<events::on_buff_gain>::add_callback(on_buff_gain);
+        event_handler<events::on_buff_lose>::add_callback(on_buff_lose);
 
         // Permashow setup for Kennen
         Permashow::Instance.Init(settings::main_tab, "Kennen");
@@ -586,6 +801,8 @@ namespace kennen
         if (r) plugin_sdk->remove_spell(r);
         event_handler<events::on_update>::remove_handler(on_update);
         event_handler<events::on_draw>::remove_handler(on_draw);
+        event_handler<events::on_buff_gain>::remove_handler(on_buff_gain);
+        event_handler<events::on_buff_lose>::remove_handler(on_buff_lose);
         console->print("Kennen plugin unloaded!");
     }
 } 
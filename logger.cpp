@@ -0,0 +1,161 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+#include "logger.h"
+#include <array>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <algorithm>
+
+namespace logger
+{
+    constexpr std::size_t RING_SIZE = 4096; // power of two
+    constexpr long MAX_FILE_BYTES = 4 * 1024 * 1024;
+    constexpr auto WRITER_INTERVAL = std::chrono::milliseconds(20);
+
+    // Single producer (game thread), single consumer (writer thread)
+    static std::array<record, RING_SIZE> ring;
+    static std::atomic<std::size_t> head{ 0 };
+    static std::atomic<std::size_t> tail{ 0 };
+    static std::atomic<std::uint64_t> dropped{ 0 };
+
+    static std::atomic<bool> active{ false };
+    static std::atomic<bool> running{ false };
+    static std::thread writer;
+    static std::string file_path;
+
+    static const char* level_names[] = { "TRACE", "DEBUG", "INFO", "WARN", "ERROR" };
+    static const char* slot_names[] = { "Q", "W", "E", "R", "D", "F" };
+
+    const char* slot_name(std::int32_t slot)
+    {
+        return slot >= 0 && slot < 6 ? slot_names[slot] : "?";
+    }
+
+    int format_record(const record& rec, char* out, std::size_t size)
+    {
+        int n = std::snprintf(out, size, "[%.3f] [%s] ", rec.game_time, level_names[static_cast<int>(rec.lvl)]);
+        if (n < 0 || static_cast<std::size_t>(n) >= size)
+            return 0;
+
+        int m = 0;
+        switch (rec.kind)
+        {
+            case event::message:
+                m = std::snprintf(out + n, size - n, "%s %d\n", rec.text ? rec.text : "", rec.value);
+                break;
+            case event::cast_self:
+                m = std::snprintf(out + n, size - n, "cast %s\n", slot_name(rec.slot));
+                break;
+            case event::cast_position:
+                m = std::snprintf(out + n, size - n, "cast %s at (%.0f, %.0f)\n", slot_name(rec.slot), rec.x, rec.y);
+                break;
+            case event::cast_unit:
+                m = std::snprintf(out + n, size - n, "cast %s on unit %u at (%.0f, %.0f)\n", slot_name(rec.slot), rec.network_id, rec.x, rec.y);
+                break;
+            case event::cast_farm:
+                m = std::snprintf(out + n, size - n, "farm cast %s at (%.0f, %.0f)\n", slot_name(rec.slot), rec.x, rec.y);
+                break;
+            case event::collision_block:
+                m = std::snprintf(out + n, size - n, "collision precheck blocked by unit %u at (%.0f, %.0f)\n", rec.network_id, rec.x, rec.y);
+                break;
+            case event::allocations:
+                m = std::snprintf(out + n, size - n, "allocations in %s: %d (%u bytes)\n", rec.text ? rec.text : "tick", rec.value, rec.bytes);
+                break;
+        }
+        return m < 0 ? n : std::min<int>(n + m, static_cast<int>(size) - 1);
+    }
+
+    void rotate(std::FILE*& file)
+    {
+        std::fclose(file);
+        std::string backup = file_path + ".1";
+        std::remove(backup.c_str());
+        std::rename(file_path.c_str(), backup.c_str());
+        file = std::fopen(file_path.c_str(), "ab");
+    }
+
+    void writer_loop()
+    {
+        std::FILE* file = std::fopen(file_path.c_str(), "ab");
+        char line[256];
+
+        while (true)
+        {
+            bool stopping = !running.load(std::memory_order_acquire);
+
+            auto t = tail.load(std::memory_order_relaxed);
+            auto h = head.load(std::memory_order_acquire);
+            for (; t != h; ++t)
+            {
+                int len = format_record(ring[t & (RING_SIZE - 1)], line, sizeof(line));
+                if (file && len > 0)
+                    std::fwrite(line, 1, len, file);
+            }
+            tail.store(t, std::memory_order_release);
+
+            if (file)
+            {
+                std::fflush(file);
+                if (std::ftell(file) > MAX_FILE_BYTES)
+                    rotate(file);
+            }
+
+            if (stopping)
+                break;
+            std::this_thread::sleep_for(WRITER_INTERVAL);
+        }
+
+        if (file)
+            std::fclose(file);
+    }
+
+    void start(const std::string& name)
+    {
+        if (running.exchange(true))
+            return;
+        file_path = "luvvy_" + name + ".log";
+        writer = std::thread(writer_loop);
+    }
+
+    void stop()
+    {
+        active.store(false, std::memory_order_relaxed);
+        if (!running.exchange(false))
+            return;
+        if (writer.joinable())
+            writer.join();
+    }
+
+    void set_active(bool value)
+    {
+        active.store(value, std::memory_order_relaxed);
+    }
+
+    bool is_active()
+    {
+        return active.load(std::memory_order_relaxed);
+    }
+
+    void push(level lvl, record rec)
+    {
+        auto h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) >= RING_SIZE)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        rec.lvl = lvl;
+        rec.game_time = gametime->get_time();
+        rec.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        ring[h & (RING_SIZE - 1)] = rec;
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    std::uint64_t dropped_count()
+    {
+        return dropped.load(std::memory_order_relaxed);
+    }
+}
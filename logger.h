@@ -0,0 +1,107 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+
+#pragma once
+
+// Compile-time minimum level: 0 trace, 1 debug, 2 info, 3 warn, 4 error, 5 off
+#ifndef LUVVY_LOG_LEVEL
+#define LUVVY_LOG_LEVEL 1
+#endif
+
+namespace logger
+{
+    enum class level : std::uint8_t
+    {
+        trace,
+        debug,
+        info,
+        warn,
+        error
+    };
+
+    enum class event : std::uint8_t
+    {
+        message,
+        cast_self,
+        cast_position,
+        cast_unit,
+        cast_farm,
+        collision_block,
+        allocations
+    };
+
+    // Fixed-size binary record, formatted later on the writer thread
+    struct record
+    {
+        std::int64_t timestamp_ns = 0;
+        float game_time = 0.0f;
+        level lvl = level::info;
+        event kind = event::message;
+        std::int32_t slot = -1;
+        std::uint32_t network_id = 0;
+        float x = 0.0f;
+        float y = 0.0f;
+        std::int32_t value = 0;
+        std::uint32_t bytes = 0;
+        const char* text = nullptr; // must point at a string literal
+    };
+
+    constexpr bool enabled(level lvl)
+    {
+        return static_cast<int>(lvl) >= LUVVY_LOG_LEVEL;
+    }
+
+    // Record builders
+    //
+    inline record make_message(const char* text, std::int32_t value = 0)
+    {
+        record rec;
+        rec.text = text;
+        rec.value = value;
+        return rec;
+    }
+
+    inline record make_allocations(const char* scope, std::uint64_t allocations, std::uint64_t bytes)
+    {
+        record rec;
+        rec.kind = event::allocations;
+        rec.text = scope;
+        rec.value = static_cast<std::int32_t>(allocations);
+        rec.bytes = static_cast<std::uint32_t>(bytes);
+        return rec;
+    }
+
+    inline record make_cast(event kind, spellslot slot, std::uint32_t network_id = 0, const vector& pos = vector())
+    {
+        record rec;
+        rec.kind = kind;
+        rec.slot = static_cast<std::int32_t>(slot);
+        rec.network_id = network_id;
+        rec.x = pos.x;
+        rec.y = pos.y;
+        return rec;
+    }
+
+    // Writer lifetime
+    //
+    void start(const std::string& name);
+    void stop();
+
+    // Runtime switch (Developer Settings debug mode)
+    //
+    void set_active(bool active);
+    bool is_active();
+
+    // Producer side, game thread only
+    //
+    void push(level lvl, record rec);
+    std::uint64_t dropped_count();
+};
+
+// Disabled levels compile to nothing; the record expression is only evaluated when logging is on
+#define LUVVY_LOG(lvl, rec) \
+    do { \
+        if constexpr (logger::enabled(lvl)) { \
+            if (logger::is_active()) \
+                logger::push(lvl, rec); \
+        } \
+    } while (0)
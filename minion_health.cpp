@@ -0,0 +1,159 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+#include "minion_health.h"
+#include "alloc_counter.h"
+#include "watchdog.h"
+#include <array>
+#include <vector>
+#include <algorithm>
+
+namespace minion_health
+{
+    constexpr int MAX_ATTACKS = 256;
+    constexpr float ATTACK_GRACE = 0.1f;
+
+    struct incoming_attack
+    {
+        bool active = false;
+        std::uint32_t target_id = 0;
+        float hit_time = 0.0f;
+        float damage = 0.0f;
+    };
+
+    struct minion_forecast
+    {
+        float health = 0.0f;
+        std::array<float, HORIZON_COUNT> predicted = {};
+    };
+
+    // Incoming ally minion and turret attacks, oldest overwritten when full
+    static std::array<incoming_attack, MAX_ATTACKS> attacks;
+    static int attack_head = 0;
+
+    // Rebuilt in one pass per tick and read by every farm solver
+    // Both vectors keep their capacity between ticks, so steady-state rebuilds do not allocate
+    static std::vector<minion_forecast> table;
+    static std::vector<std::pair<std::uint32_t, int>> table_index;
+
+    minion_forecast* find_entry(std::uint32_t id)
+    {
+        auto it = std::lower_bound(table_index.begin(), table_index.end(), std::make_pair(id, 0));
+        if (it == table_index.end() || it->first != id)
+            return nullptr;
+        return &table[it->second];
+    }
+
+    void on_process_spell_cast(game_object_script sender, spell_instance_script spell)
+    {
+        if (!sender || !spell || !spell->is_auto_attack() || !sender->is_ally())
+            return;
+        if (!sender->is_minion() && !sender->is_ai_turret())
+            return;
+
+        auto target = entitylist->get_object(spell->get_last_target_id());
+        if (!target || !target->is_valid() || !target->is_enemy() || !target->is_minion())
+            return;
+
+        auto data = spell->get_spell_data();
+        float speed = data ? data->mMissileSpeed : 0.0f;
+        float travel = speed > 0.0f ? sender->get_distance(target) / speed : 0.0f;
+
+        auto& attack = attacks[attack_head];
+        attack_head = (attack_head + 1) % MAX_ATTACKS;
+        attack.active = true;
+        attack.target_id = target->get_id();
+        attack.hit_time = gametime->get_time() + sender->get_attack_cast_delay() + travel;
+        attack.damage = damagelib->get_auto_attack_damage(sender, target, true);
+    }
+
+    void on_update()
+    {
+        alloc_counter::probe probe("minion_health::on_update");
+        watchdog::scope timer("minion_health::on_update");
+
+        float now = gametime->get_time();
+
+        table.clear();
+        table_index.clear();
+        for (auto& minion : entitylist->get_enemy_minions())
+        {
+            if (!minion || !minion->is_valid() || minion->is_dead())
+                continue;
+
+            minion_forecast entry;
+            entry.health = minion->get_health();
+            entry.predicted.fill(entry.health);
+            table_index.push_back({ minion->get_id(), static_cast<int>(table.size()) });
+            table.push_back(entry);
+        }
+        std::sort(table_index.begin(), table_index.end());
+
+        for (auto& attack : attacks)
+        {
+            if (!attack.active)
+                continue;
+
+            float delta = attack.hit_time - now;
+            auto found = find_entry(attack.target_id);
+            if (delta < -ATTACK_GRACE || !found)
+            {
+                attack.active = false;
+                continue;
+            }
+
+            auto& entry = *found;
+            for (int i = 0; i < HORIZON_COUNT; ++i)
+            {
+                if (delta <= HORIZONS[i])
+                    entry.predicted[i] -= attack.damage;
+            }
+        }
+    }
+
+    void load()
+    {
+        attacks.fill(incoming_attack{});
+        attack_head = 0;
+
+        event_handler<events::on_update>::add_callback(on_update);
+        event_handler<events::on_process_spell_cast>::add_callback(on_process_spell_cast);
+    }
+
+    void unload()
+    {
+        event_handler<events::on_update>::remove_handler(on_update);
+        event_handler<events::on_process_spell_cast>::remove_handler(on_process_spell_cast);
+        table.clear();
+        table_index.clear();
+    }
+
+    float get_predicted_health(game_object_script minion, float seconds)
+    {
+        if (!minion)
+            return 0.0f;
+
+        auto found = find_entry(minion->get_id());
+        if (!found)
+            return minion->get_health();
+
+        const auto& entry = *found;
+        float prev_time = 0.0f;
+        float prev_health = entry.health;
+        for (int i = 0; i < HORIZON_COUNT; ++i)
+        {
+            if (seconds <= HORIZONS[i])
+            {
+                float t = (seconds - prev_time) / (HORIZONS[i] - prev_time);
+                return prev_health + (entry.predicted[i] - prev_health) * std::max(t, 0.0f);
+            }
+            prev_time = HORIZONS[i];
+            prev_health = entry.predicted[i];
+        }
+        return entry.predicted[HORIZON_COUNT - 1];
+    }
+
+    bool is_killable(game_object_script minion, float damage, float seconds)
+    {
+        float health = get_predicted_health(minion, seconds);
+        return health > 0.0f && health <= damage;
+    }
+}
@@ -0,0 +1,21 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+
+#pragma once
+namespace minion_health
+{
+    // Forecast horizons in seconds
+    constexpr int HORIZON_COUNT = 3;
+    constexpr float HORIZONS[HORIZON_COUNT] = { 0.25f, 0.5f, 1.0f };
+
+    // Tracker lifetime
+    //
+    void load();
+    void unload();
+
+    // Queries
+    //
+    // Predicted health `seconds` from now, interpolated between horizons
+    float get_predicted_health(game_object_script minion, float seconds);
+    // True if `damage` landing after `seconds` takes the last hit (the minion is still alive then and dies to it)
+    bool is_killable(game_object_script minion, float damage, float seconds);
+};
@@ -0,0 +1,291 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+#include "movement.h"
+#include "alloc_counter.h"
+#include "watchdog.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace movement
+{
+    // A path younger than this is still likely to be a click in progress
+    constexpr float PATH_STABLE_TIME = 0.4f;
+    // Long flights are less certain even on a stable path
+    constexpr float LONG_FLIGHT_TIME = 1.5f;
+    constexpr float VELOCITY_WINDOW = 0.2f;
+    constexpr float DIRECTION_CHANGE_DOT = 0.98f;
+    constexpr float WAYPOINT_REACHED = 25.0f;
+
+    // Position history and current path per enemy hero, stored as plain arrays. Heroes live for the
+    // whole game, so the strong reference cannot go stale and needs no entity handle.
+    struct hero_track
+    {
+        game_object_script hero = nullptr;
+        std::uint32_t network_id = 0;
+
+        float t[HISTORY] = {};
+        float x[HISTORY] = {};
+        float y[HISTORY] = {};
+        int head = 0;
+        int count = 0;
+
+        bool moving = false;
+        float dir_x = 0.0f;
+        float dir_y = 0.0f;
+        float speed = 0.0f;
+        float path_time = 0.0f;
+
+        float wx[MAX_WAYPOINTS] = {};
+        float wy[MAX_WAYPOINTS] = {};
+        int waypoint_count = 0;
+        int next_waypoint = 0;
+    };
+
+    static hero_track tracks[MAX_TRACKED];
+    static int track_count = 0;
+
+    static hero_track* find_track(game_object_script hero)
+    {
+        auto id = hero->get_network_id();
+        for (int i = 0; i < track_count; ++i)
+        {
+            if (tracks[i].network_id == id)
+                return &tracks[i];
+        }
+        return nullptr;
+    }
+
+    // get_path allocates, so it is only read when the movement direction changes
+    static void refresh_path(hero_track& track, float now)
+    {
+        track.path_time = now;
+        track.waypoint_count = 0;
+        track.next_waypoint = 0;
+
+        auto path = track.hero->get_path();
+        for (size_t i = 1; i < path.size() && track.waypoint_count < MAX_WAYPOINTS; ++i)
+        {
+            track.wx[track.waypoint_count] = path[i].x;
+            track.wy[track.waypoint_count] = path[i].y;
+            track.waypoint_count++;
+        }
+    }
+
+    static void sample(hero_track& track, float now)
+    {
+        auto hero = track.hero;
+        if (!hero->is_visible() || hero->is_dead())
+        {
+            track.count = 0;
+            track.moving = false;
+            track.waypoint_count = 0;
+            return;
+        }
+
+        auto pos = hero->get_position();
+        track.t[track.head] = now;
+        track.x[track.head] = pos.x;
+        track.y[track.head] = pos.y;
+        track.head = (track.head + 1) % HISTORY;
+        track.count = std::min(track.count + 1, HISTORY);
+
+        bool moving = hero->is_moving();
+        vector dir = moving ? hero->get_pathing_direction().normalized() : vector();
+        bool turned = moving && track.moving && dir.x * track.dir_x + dir.y * track.dir_y < DIRECTION_CHANGE_DOT;
+        if (moving != track.moving || turned)
+        {
+            if (moving)
+                refresh_path(track, now);
+            else
+            {
+                track.path_time = now;
+                track.waypoint_count = 0;
+            }
+        }
+        track.moving = moving;
+        track.dir_x = dir.x;
+        track.dir_y = dir.y;
+        track.speed = hero->get_move_speed();
+
+        // Drop waypoints already passed
+        while (track.next_waypoint < track.waypoint_count)
+        {
+            float dx = track.wx[track.next_waypoint] - pos.x, dy = track.wy[track.next_waypoint] - pos.y;
+            if (dx * dx + dy * dy > WAYPOINT_REACHED * WAYPOINT_REACHED && dx * track.dir_x + dy * track.dir_y > 0.0f)
+                break;
+            track.next_waypoint++;
+        }
+    }
+
+    void on_update()
+    {
+        alloc_counter::probe probe("movement::on_update");
+        watchdog::scope timer("movement::on_update");
+
+        float now = gametime->get_time();
+        for (int i = 0; i < track_count; ++i)
+            sample(tracks[i], now);
+    }
+
+    void load()
+    {
+        track_count = 0;
+        for (auto& enemy : entitylist->get_enemy_heroes())
+        {
+            if (!enemy || track_count == MAX_TRACKED)
+                continue;
+            tracks[track_count] = hero_track{};
+            tracks[track_count].hero = enemy;
+            tracks[track_count].network_id = enemy->get_network_id();
+            track_count++;
+        }
+
+        event_handler<events::on_update>::add_callback(on_update);
+    }
+
+    void unload()
+    {
+        event_handler<events::on_update>::remove_handler(on_update);
+        for (int i = 0; i < track_count; ++i)
+            tracks[i].hero = nullptr;
+        track_count = 0;
+    }
+
+    // Agreement between the velocity measured from history and the one the path implies
+    static float velocity_agreement(const hero_track& track)
+    {
+        if (track.count < 2)
+            return 0.5f;
+
+        int newest = (track.head + HISTORY - 1) % HISTORY;
+        int oldest = newest;
+        for (int i = 1; i < track.count; ++i)
+        {
+            int index = (newest + HISTORY - i) % HISTORY;
+            oldest = index;
+            if (track.t[newest] - track.t[index] >= VELOCITY_WINDOW)
+                break;
+        }
+
+        float dt = track.t[newest] - track.t[oldest];
+        if (dt <= 0.0f)
+            return 0.5f;
+
+        float vx = (track.x[newest] - track.x[oldest]) / dt, vy = (track.y[newest] - track.y[oldest]) / dt;
+        float ex = track.moving ? track.dir_x * track.speed : 0.0f, ey = track.moving ? track.dir_y * track.speed : 0.0f;
+        float error = std::sqrt((vx - ex) * (vx - ex) + (vy - ey) * (vy - ey));
+        return std::clamp(1.0f - error / std::max(track.speed, 1.0f), 0.0f, 1.0f);
+    }
+
+    // Smallest t in [lo, hi] with (a t^2 + 2 b t + c) <= 0, or a negative value if none
+    static float first_hit(float a, float b, float c, float lo, float hi)
+    {
+        auto g = [&](float t) { return (a * t + 2.0f * b) * t + c; };
+        if (g(lo) <= 0.0f)
+            return lo;
+
+        float root = -1.0f;
+        if (std::fabs(a) < 1e-6f)
+        {
+            if (std::fabs(b) > 1e-6f)
+                root = -c / (2.0f * b);
+        }
+        else
+        {
+            float disc = b * b - a * c;
+            if (disc >= 0.0f)
+            {
+                float sq = std::sqrt(disc);
+                float r1 = (-b - sq) / a, r2 = (-b + sq) / a;
+                if (r1 > r2) std::swap(r1, r2);
+                root = r1 >= lo ? r1 : r2;
+            }
+        }
+        return root >= lo && root <= hi ? root : -1.0f;
+    }
+
+    bool solve_intercept(game_object_script target, const vector& from, const spell_data::spell_desc& spell, aim& out)
+    {
+        if (!target)
+            return false;
+        auto track = find_track(target);
+        if (!track || track->count == 0)
+            return false;
+
+        auto pos = target->get_position();
+        float reach_bonus = spell.width + target->get_bounding_radius();
+
+        // Walk the path segment by segment; the last one is standing still forever
+        float seg_x = pos.x, seg_y = pos.y, seg_start = 0.0f;
+        int waypoint = track->moving ? track->next_waypoint : track->waypoint_count;
+        float hit_time = -1.0f, hit_x = pos.x, hit_y = pos.y;
+        while (true)
+        {
+            float ux = 0.0f, uy = 0.0f, seg_end = std::numeric_limits<float>::max();
+            if (waypoint < track->waypoint_count && track->speed > 0.0f)
+            {
+                float dx = track->wx[waypoint] - seg_x, dy = track->wy[waypoint] - seg_y;
+                float length = std::sqrt(dx * dx + dy * dy);
+                if (length > 0.0f)
+                {
+                    ux = dx / length * track->speed;
+                    uy = dy / length * track->speed;
+                    seg_end = seg_start + length / track->speed;
+                }
+            }
+
+            float lo = std::max(seg_start, spell.delay);
+            if (lo <= seg_end)
+            {
+                if (spell.speed <= 0.0f)
+                {
+                    hit_time = lo;
+                }
+                else
+                {
+                    // |P(t) - from| <= speed * (t - delay) + reach_bonus, P(t) = D + u t
+                    float dx = seg_x - ux * seg_start - from.x, dy = seg_y - uy * seg_start - from.y;
+                    float c0 = reach_bonus - spell.speed * spell.delay;
+                    float a = ux * ux + uy * uy - spell.speed * spell.speed;
+                    float b = dx * ux + dy * uy - spell.speed * c0;
+                    float c = dx * dx + dy * dy - c0 * c0;
+                    hit_time = first_hit(a, b, c, lo, seg_end);
+                }
+                if (hit_time >= 0.0f)
+                {
+                    hit_x = seg_x + ux * (hit_time - seg_start);
+                    hit_y = seg_y + uy * (hit_time - seg_start);
+                    break;
+                }
+            }
+
+            if (seg_end == std::numeric_limits<float>::max())
+                return false;
+            seg_x = track->wx[waypoint];
+            seg_y = track->wy[waypoint];
+            seg_start = seg_end;
+            waypoint++;
+        }
+
+        float hx = hit_x - from.x, hy = hit_y - from.y;
+        if (hx * hx + hy * hy > spell.range * spell.range)
+            return false;
+
+        float now = gametime->get_time();
+        float path_confidence = track->moving ? std::clamp((now - track->path_time) / PATH_STABLE_TIME, 0.0f, 1.0f) : 1.0f;
+        float flight_confidence = std::clamp(1.0f - 0.5f * hit_time / LONG_FLIGHT_TIME, 0.0f, 1.0f);
+
+        out.position = vector(hit_x, hit_y, pos.z);
+        out.time = hit_time;
+        out.confidence = path_confidence * velocity_agreement(*track) * flight_confidence;
+        return true;
+    }
+
+    bool can_reach(game_object_script target, const vector& from, const spell_data::spell_desc& spell)
+    {
+        if (!target || !find_track(target))
+            return true;
+        aim unused;
+        return solve_intercept(target, from, spell, unused);
+    }
+}
@@ -0,0 +1,31 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+#include "spell_data.h"
+
+#pragma once
+namespace movement
+{
+    constexpr int MAX_TRACKED = 10;
+    constexpr int HISTORY = 16;
+    constexpr int MAX_WAYPOINTS = 8;
+    // Below this the caller should fall back to the SDK prediction
+    constexpr float MIN_CONFIDENCE = 0.5f;
+
+    struct aim
+    {
+        vector position;
+        float time = 0.0f;          // seconds until the spell reaches the target
+        float confidence = 0.0f;    // 0..1, how much the current path can be trusted
+    };
+
+    // Tracker lifetime
+    //
+    void load();
+    void unload();
+
+    // Closed-form intercept of a spell cast from `from` against the target's current waypoints.
+    // Returns false when the target is not tracked or the intercept lies outside the spell range.
+    //
+    bool solve_intercept(game_object_script target, const vector& from, const spell_data::spell_desc& spell, aim& out);
+    // Pre-filter before SDK prediction: false only when the tracked path puts the target out of reach
+    bool can_reach(game_object_script target, const vector& from, const spell_data::spell_desc& spell);
+};
@@ -0,0 +1,256 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+#include "parallel.h"
+#include "logger.h"
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+namespace parallel
+{
+    // Each participant owns a contiguous range of chunk indices packed as (lo | hi << 32).
+    // The owner pops from lo and thieves take from hi, both with a CAS on the same word.
+    struct alignas(64) chunk_queue
+    {
+        std::atomic<std::uint64_t> bounds{ 0 };
+    };
+
+    static std::uint64_t pack(std::uint32_t lo, std::uint32_t hi)
+    {
+        return static_cast<std::uint64_t>(lo) | (static_cast<std::uint64_t>(hi) << 32);
+    }
+
+    static bool pop_front(chunk_queue& queue, int& chunk)
+    {
+        auto bounds = queue.bounds.load(std::memory_order_acquire);
+        while (true)
+        {
+            auto lo = static_cast<std::uint32_t>(bounds), hi = static_cast<std::uint32_t>(bounds >> 32);
+            if (lo >= hi)
+                return false;
+            if (queue.bounds.compare_exchange_weak(bounds, pack(lo + 1, hi), std::memory_order_acq_rel))
+            {
+                chunk = static_cast<int>(lo);
+                return true;
+            }
+        }
+    }
+
+    static bool steal_back(chunk_queue& queue, int& chunk)
+    {
+        auto bounds = queue.bounds.load(std::memory_order_acquire);
+        while (true)
+        {
+            auto lo = static_cast<std::uint32_t>(bounds), hi = static_cast<std::uint32_t>(bounds >> 32);
+            if (lo >= hi)
+                return false;
+            if (queue.bounds.compare_exchange_weak(bounds, pack(lo, hi - 1), std::memory_order_acq_rel))
+            {
+                chunk = static_cast<int>(hi - 1);
+                return true;
+            }
+        }
+    }
+
+    struct job
+    {
+        chunk_fn fn = nullptr;
+        void* context = nullptr;
+        int count = 0;
+        int chunk_size = CHUNK_SIZE;
+        int participants = 0;
+        std::atomic<int> remaining{ 0 };
+        // Generation of the job while it accepts helpers, 0 once closed
+        std::atomic<std::uint64_t> open_generation{ 0 };
+        // Workers between waking and leaving; only these can still touch the job
+        std::atomic<int> inside{ 0 };
+    };
+
+    static chunk_queue queues[MAX_THREADS];
+    static job current;
+    static std::vector<std::thread> threads;
+    static std::once_flag started;
+    static std::atomic<int> worker_count{ 0 };
+    static std::mutex wake_mutex;
+    static std::condition_variable wake;
+    static std::uint64_t generation = 0;
+    static bool stopping = false;
+    static std::atomic<bool> busy{ false };
+
+    static void participate(int self)
+    {
+        int chunk = 0;
+        while (true)
+        {
+            bool found = pop_front(queues[self], chunk);
+            for (int i = 1; !found && i < current.participants; ++i)
+                found = steal_back(queues[(self + i) % current.participants], chunk);
+            if (!found)
+                return;
+
+            int begin = chunk * current.chunk_size;
+            int end = std::min(begin + current.chunk_size, current.count);
+            current.fn(current.context, begin, end);
+            current.remaining.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    static void thread_loop(int self)
+    {
+        std::uint64_t seen = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(wake_mutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping)
+                    return;
+                seen = generation;
+            }
+
+            // A worker that wakes after the job closed (or was never picked) leaves without touching it.
+            // seq_cst on both sides: either the worker sees the job closed or run_chunks sees it inside.
+            current.inside.fetch_add(1);
+            if (current.open_generation.load() == seen && self < current.participants)
+                participate(self);
+            current.inside.fetch_sub(1);
+        }
+    }
+
+    // Threads are only created by the first call that actually goes parallel, champions without
+    // farm solvers never start the pool
+    static void start_workers()
+    {
+        int hardware = static_cast<int>(std::thread::hardware_concurrency());
+        int workers = std::min(std::max(hardware - 1, 0), MAX_THREADS - 1);
+
+        for (int i = 1; i <= workers; ++i)
+            threads.emplace_back(thread_loop, i);
+        worker_count.store(workers, std::memory_order_release);
+    }
+
+    void load()
+    {
+        stopping = false;
+    }
+
+    void unload()
+    {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& thread : threads)
+            thread.join();
+        threads.clear();
+    }
+
+    int thread_count()
+    {
+        std::call_once(started, start_workers);
+        return worker_count.load(std::memory_order_acquire) + 1;
+    }
+
+    void run_chunks(int count, chunk_fn fn, void* context, int max_threads, int chunk_size)
+    {
+        chunk_size = std::max(chunk_size, 1);
+        if (count < SERIAL_THRESHOLD * chunk_size / CHUNK_SIZE || max_threads <= 1)
+        {
+            fn(context, 0, count);
+            return;
+        }
+
+        int participants = std::min(max_threads, thread_count());
+        if (participants <= 1 || busy.exchange(true, std::memory_order_acquire))
+        {
+            fn(context, 0, count);
+            return;
+        }
+
+        int chunks = (count + chunk_size - 1) / chunk_size;
+        participants = std::min(participants, chunks);
+        for (int i = 0; i < participants; ++i)
+        {
+            auto lo = static_cast<std::uint32_t>(chunks * i / participants);
+            auto hi = static_cast<std::uint32_t>(chunks * (i + 1) / participants);
+            queues[i].bounds.store(pack(lo, hi), std::memory_order_relaxed);
+        }
+
+        current.fn = fn;
+        current.context = context;
+        current.count = count;
+        current.chunk_size = chunk_size;
+        current.participants = participants;
+        current.remaining.store(chunks, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex);
+            ++generation;
+            current.open_generation.store(generation);
+        }
+        wake.notify_all();
+
+        participate(0);
+
+        // Only chunks other threads already claimed are waited on; helpers that have not woken yet
+        // find the job closed and never join
+        while (current.remaining.load(std::memory_order_acquire) > 0)
+            std::this_thread::yield();
+        current.open_generation.store(0);
+        while (current.inside.load() > 0)
+            std::this_thread::yield();
+
+        busy.store(false, std::memory_order_release);
+    }
+
+    void score_circles(const circle_point* centers, int center_count, const circle_point* units, int unit_count,
+        float radius, float kill_weight, int* counts, float* scores, int max_threads)
+    {
+        auto score_range = [&](int begin, int end)
+        {
+            circle_scoring::score_range(centers, begin, end, units, unit_count, radius, kill_weight, counts, scores);
+        };
+        for_chunks(center_count, score_range, max_threads);
+    }
+
+    int pick_best(const float* scores, int count)
+    {
+        return circle_scoring::pick_best(scores, count);
+    }
+
+    void run_benchmark()
+    {
+        constexpr int UNITS = 2000;
+        constexpr int REPEATS = 20;
+
+        std::mt19937 rng(1337);
+        std::uniform_real_distribution<float> coord(0.0f, 2500.0f);
+        std::vector<circle_point> units(UNITS);
+        for (auto& unit : units)
+            unit = { coord(rng), coord(rng), (rng() & 7) == 0 };
+
+        std::vector<int> counts(UNITS), reference_counts(UNITS);
+        std::vector<float> scores(UNITS), reference_scores(UNITS);
+        score_circles(units.data(), UNITS, units.data(), UNITS, 150.0f, 1.0f, reference_counts.data(), reference_scores.data(), 1);
+
+        double serial_ms = 0.0;
+        for (int threads_used = 1; threads_used <= thread_count(); ++threads_used)
+        {
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < REPEATS; ++i)
+                score_circles(units.data(), UNITS, units.data(), UNITS, 150.0f, 1.0f, counts.data(), scores.data(), threads_used);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / REPEATS;
+            if (threads_used == 1)
+                serial_ms = ms;
+
+            bool match = counts == reference_counts && scores == reference_scores;
+            console->print("[luvvy] solver benchmark: %d units, %d thread(s): %.3f ms, speedup %.2fx, %s",
+                UNITS, threads_used, ms, serial_ms / ms, match ? "matches serial" : "MISMATCH");
+            LUVVY_LOG(logger::level::info, logger::make_message("solver benchmark us per run", static_cast<std::int32_t>(ms * 1000.0)));
+        }
+    }
+}
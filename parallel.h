@@ -0,0 +1,43 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+#include "circle_scoring.h"
+
+#pragma once
+namespace parallel
+{
+    // Below this many candidates the pool is not worth waking up
+    constexpr int SERIAL_THRESHOLD = 48;
+    constexpr int CHUNK_SIZE = 16;
+    constexpr int MAX_THREADS = 8;
+
+    using circle_point = circle_scoring::point;
+
+    // Pool lifetime
+    //
+    void load();
+    void unload();
+    int thread_count();
+
+    // Runs fn(context, begin, end) over [0, count) in chunk_size chunks. The calling thread takes part,
+    // idle participants steal chunks from the others. Falls back to a serial call under the threshold
+    // (scaled with chunk_size), when the pool is busy, or when max_threads is 1.
+    using chunk_fn = void (*)(void* context, int begin, int end);
+    void run_chunks(int count, chunk_fn fn, void* context, int max_threads = MAX_THREADS, int chunk_size = CHUNK_SIZE);
+
+    template <class F>
+    void for_chunks(int count, F& fn, int max_threads = MAX_THREADS, int chunk_size = CHUNK_SIZE)
+    {
+        run_chunks(count, [](void* context, int begin, int end) { (*static_cast<F*>(context))(begin, end); }, &fn, max_threads, chunk_size);
+    }
+
+    // Candidate scoring
+    //
+    // counts[i] / scores[i] for a `radius` circle on centers[i]: units inside, plus kill_weight per killable unit.
+    // Each candidate is scored independently, so parallel and serial runs produce identical arrays.
+    void score_circles(const circle_point* centers, int center_count, const circle_point* units, int unit_count,
+        float radius, float kill_weight, int* counts, float* scores, int max_threads = MAX_THREADS);
+    // Index of the highest score (lowest index on ties), -1 if nothing scored
+    int pick_best(const float* scores, int count);
+
+    // Times score_circles on a synthetic wave with 1..N threads and prints the results
+    void run_benchmark();
+};
@@ -1,4 +1,5 @@
 #include "permashow.hpp"
+#include "watchdog.h"
 #include <array>
 
 TreeTab* permashow = nullptr;
@@ -77,7 +78,10 @@ void Permashow_FontChange(TreeEntry*) {
 }
 
 void Permashow_OnDraw() {
-    if (permashow_update) {
+    watchdog::scope timer("permashow::on_draw");
+
+    // A pending relayout waits while the watchdog has the layout frozen
+    if (permashow_update && watchdog::update_permashow_layout()) {
         Permashow::Instance.Update();
         permashow_update = false;
     }
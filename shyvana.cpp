@@ -1,6 +1,14 @@
 #include "shyvana.h"
 #include "../plugin_sdk/plugin_sdk.hpp"
 #include "utils.h"
+#include "parallel.h"
+#include "spell_data.h"
+#include "movement.h"
+#include "jungle.h"
+#include "waves.h"
+#include "alloc_counter.h"
+#include "watchdog.h"
+#include "tuner.h"
 #include "permashow.hpp"
 #include <vector>
 #include <string>
@@ -8,16 +16,7 @@
 
 namespace shyvana
 {
-    constexpr float E_RANGE = 925.0f;
-    constexpr float E_SPEED = 1600.0f;
-    constexpr float E_SPEED_DRAGON = 1575.0f;
-    constexpr float E_WIDTH = 120.0f;
-    constexpr float E_CAST_TIME = 0.25f;
-    constexpr float E_CAST_TIME_DRAGON = 0.3333f;
-    constexpr float E_RADIUS_DRAGON = 345.0f;
-
-    // How far behind the enemy to aim (tweak as needed)
-    constexpr float E_LEAD_DISTANCE = 400.0f;
+    constexpr float E_RANGE = spell_data::shyvana::E.range;
 
     static script_spell* e = nullptr;
     static TreeTab* main_tab = nullptr;
@@ -34,69 +33,61 @@ namespace shyvana
 
     hit_chance get_hitchance_by_config(TreeEntry* hit)
     {
+        hit_chance value = hit_chance::high;
         switch (hit ? hit->get_int() : 2)
         {
-            case 0: return hit_chance::low;
-            case 1: return hit_chance::medium;
-            case 2: return hit_chance::high;
-            case 3: return hit_chance::very_high;
-            default: return hit_chance::high;
+            case 0: value = hit_chance::low; break;
+            case 1: value = hit_chance::medium; break;
+            case 3: value = hit_chance::very_high; break;
+            default: break;
         }
+        // Capped while the watchdog sheds work
+        return watchdog::clamp_hitchance(value);
     }
 
-    bool in_dragon_form()
-    {
-        return myhero->has_buff(buff_hash("ShyvanaTransform"));
-    }
+    // --- E PROFILES ---
+    // Human and dragon descriptors from spell_data, switched only from the ShyvanaTransform buff
+    // events so the casting and laneclear loops never look up buffs.
+    static const std::uint32_t TRANSFORM_BUFF_HASH = buff_hash("ShyvanaTransform");
+    static const spell_data::spell_desc* active_e_profile = &spell_data::shyvana::E;
 
-    float get_e_speed()
+    void set_dragon_form(bool dragon)
     {
-        return in_dragon_form() ? E_SPEED_DRAGON : E_SPEED;
-    }
+        const spell_data::spell_desc* profile = dragon ? &spell_data::shyvana::E_DRAGON : &spell_data::shyvana::E;
+        if (profile == active_e_profile)
+            return;
 
-    float get_e_width()
-    {
-        return in_dragon_form() ? E_RADIUS_DRAGON : E_WIDTH;
+        active_e_profile = profile;
+        spell_data::apply_skillshot(e, *profile);
     }
 
-    float get_e_casttime()
+    void on_buff_gain(game_object_script sender, buff_instance_script buff)
     {
-        return in_dragon_form() ? E_CAST_TIME_DRAGON : E_CAST_TIME;
+        if (sender == myhero && buff && buff->get_hash_name() == TRANSFORM_BUFF_HASH)
+            set_dragon_form(true);
     }
 
-    void update_e_params()
+    void on_buff_lose(game_object_script sender, buff_instance_script buff)
     {
-        e->set_skillshot(
-            get_e_casttime(),
-            get_e_width(),
-            get_e_speed(),
-            { collisionable_objects::minions, collisionable_objects::heroes },
-            skillshot_type::skillshot_line
-        );
+        if (sender == myhero && buff && buff->get_hash_name() == TRANSFORM_BUFF_HASH)
+            set_dragon_form(false);
     }
 
-    vector get_e_aim_position(game_object_script target)
+    // Closed-form intercept on the tracked path; the SDK prediction only runs when that path is not trusted
+    bool get_e_cast_position(game_object_script target, vector& out)
     {
-        vector from = myhero->get_position();
-        vector to = target->get_position();
-        vector dir = target->get_pathing_direction();
-
-        // If they are running, dir is not zero, use it.
-        if (dir.length() > 0.1f)
+        movement::aim aim;
+        if (movement::solve_intercept(target, myhero->get_position(), *active_e_profile, aim) && aim.confidence >= movement::MIN_CONFIDENCE)
         {
-            // Predict a spot behind the target, toward their movement
-            vector cast_pos = to + dir.normalized() * E_LEAD_DISTANCE;
-
-            // Clamp to max range from player
-            if (from.distance(cast_pos) > E_RANGE)
-            {
-                cast_pos = from + (cast_pos - from).normalized() * E_RANGE;
-            }
-
-            return cast_pos;
+            out = aim.position;
+            return true;
         }
-        // If not moving, just cast at them
-        return to;
+
+        auto pred = e->get_prediction(target);
+        if (pred.hitchance < get_hitchance_by_config(settings::e_hitchance))
+            return false;
+        out = pred.get_cast_position();
+        return true;
     }
 
     void combo()
@@ -105,15 +96,9 @@ namespace shyvana
             return;
 
         auto target = target_selector->get_target(E_RANGE, damage_type::magical);
-        if (target && target->is_valid_target(E_RANGE))
-        {
-            update_e_params();
-
-            // Use custom aim position if moving, otherwise use prediction
-            vector cast_pos = get_e_aim_position(target);
-
-            e->cast(cast_pos);
-        }
+        vector cast_pos;
+        if (target && target->is_valid_target(E_RANGE) && get_e_cast_position(target, cast_pos))
+            utils::cast(e, cast_pos);
     }
 
     void harass()
@@ -123,11 +108,10 @@ namespace shyvana
 
         for (auto& target : entitylist->get_enemy_heroes())
         {
-            if (target && target->is_valid_target(E_RANGE))
+            vector cast_pos;
+            if (target && target->is_valid_target(E_RANGE) && get_e_cast_position(target, cast_pos))
             {
-                update_e_params();
-                vector cast_pos = get_e_aim_position(target);
-                e->cast(cast_pos);
+                utils::cast(e, cast_pos);
                 break;
             }
         }
@@ -139,37 +123,81 @@ namespace shyvana
     {
         if (!settings::use_e_laneclear->get_bool() || !e->is_ready())
             return;
+        if (!watchdog::should_run_farm())
+            return;
 
-        auto minions = entitylist->get_enemy_minions();
-        std::sort(minions.begin(), minions.end(), [](game_object_script a, game_object_script b)
-        {
-            return a->get_position().distance(myhero->get_position()) < b->get_position().distance(myhero->get_position());
-        });
-
+        // Dragon E is wider than a wave cell, so only the total count in reach is a safe bound
+        auto hero_pos = myhero->get_position();
         int required = settings::minions_hit->get_int();
+        if (waves::count_in_range(hero_pos, E_RANGE + active_e_profile->width) < required)
+            return;
 
+        struct ranked_minion
+        {
+            float distance;
+            game_object_script unit;
+        };
+
+        auto& minions = entitylist->get_enemy_minions();
+        utils::frame_vector<ranked_minion> ranked;
+        ranked.reserve(minions.size());
         for (auto& minion : minions)
         {
             if (!minion || !minion->is_valid() || minion->is_dead() || !minion->is_valid_target(E_RANGE))
                 continue;
+            ranked.push_back({ minion->get_position().distance(hero_pos), minion });
+        }
+        std::sort(ranked.begin(), ranked.end(), [](const ranked_minion& a, const ranked_minion& b)
+        {
+            return a.distance < b.distance;
+        });
 
-            auto pred = e->get_prediction(minion);
+        // Predictions stay on the game thread; the quadratic hit counting goes through the pool
+        utils::frame_vector<parallel::circle_point> units;
+        utils::frame_vector<parallel::circle_point> centers;
+        utils::frame_vector<vector> cast_positions;
+        utils::frame_vector<utils::entity_handle> handles;
+        bool recording = tuner::is_recording();
+        units.reserve(minions.size());
+        centers.reserve(ranked.size());
+        cast_positions.reserve(ranked.size());
+        for (auto& m : minions)
+        {
+            if (!m || !m->is_valid() || m->is_dead())
+                continue;
+            auto pos = m->get_position();
+            units.push_back({ pos.x, pos.y, false });
+            if (recording)
+                handles.push_back(utils::make_handle(m));
+        }
+        for (auto& entry : ranked)
+        {
+            auto pred = e->get_prediction(entry.unit);
             if (!pred._cast_position.is_valid())
                 continue;
+            centers.push_back({ pred._cast_position.x, pred._cast_position.y, false });
+            cast_positions.push_back(pred._cast_position);
+        }
 
-            int count = 0;
-            for (auto& m : minions)
-            {
-                if (!m || !m->is_valid() || m->is_dead())
-                    continue;
-                if (pred._cast_position.distance(m->get_position()) < get_e_width())
-                    count++;
-            }
+        int candidate_count = static_cast<int>(centers.size());
+        utils::frame_vector<int> counts(candidate_count);
+        utils::frame_vector<float> scores(candidate_count);
+        parallel::score_circles(centers.data(), candidate_count, units.data(), static_cast<int>(units.size()),
+            active_e_profile->width, 0.0f, counts.data(), scores.data());
+
+        if (recording)
+        {
+            float impact_window = active_e_profile->delay + E_RANGE / active_e_profile->speed;
+            tuner::record_farm(spellslot::e, units.data(), handles.data(), static_cast<int>(units.size()), centers.data(), candidate_count,
+                active_e_profile->width, 0.0f, tuner_format::farm_policy::first_fit, impact_window);
+        }
 
-            if (count >= required)
+        // Closest candidate that hits enough minions, same order as before
+        for (int i = 0; i < candidate_count; ++i)
+        {
+            if (counts[i] >= required)
             {
-                update_e_params();
-                e->cast(pred._cast_position);
+                utils::cast(e, cast_positions[i]);
                 break;
             }
         }
@@ -180,27 +208,19 @@ namespace shyvana
         if (!settings::use_e_jungle->get_bool() || !e->is_ready())
             return;
 
-        auto monsters = entitylist->get_jugnle_mobs_minions();
-        std::sort(monsters.begin(), monsters.end(), [](game_object_script a, game_object_script b)
-        {
-            return a->get_max_health() > b->get_max_health();
-        });
-
-        for (auto& mob : monsters)
-        {
-            if (!mob || !mob->is_valid() || mob->is_dead() || mob->is_ward() || !mob->is_valid_target(E_RANGE))
-                continue;
-            if (mob->get_health() < 200.0f)
-                continue;
-
-            update_e_params();
-            e->cast(mob->get_position());
-            break;
-        }
+        // Same pick as the old mob list scan (biggest monster in range with at least 200 HP), but only
+        // over the camp in range
+        auto hero_pos = myhero->get_position();
+        auto target = jungle::get_biggest_monster(jungle::get_camp_in_range(hero_pos, E_RANGE), hero_pos, E_RANGE, 200.0f);
+        if (target)
+            utils::cast(e, target->get_position());
     }
 
     void on_update()
     {
+        alloc_counter::probe probe("shyvana::on_update");
+        watchdog::scope timer("shyvana::on_update");
+
         if (orbwalker->combo_mode())
             combo();
         if (orbwalker->harass())
@@ -214,10 +234,15 @@ namespace shyvana
 
     void load()
     {
-        e = plugin_sdk->register_spell(spellslot::e, E_RANGE);
+        e = spell_data::register_spell(spell_data::shyvana::E);
+        active_e_profile = &spell_data::shyvana::E;
+        // Loading mid-game while transformed
+        set_dragon_form(myhero->has_buff(TRANSFORM_BUFF_HASH));
 
         main_tab = menu->create_tab("carry.shyvana", "Shyvana");
 
+        utils::on_load(main_tab);
+
         auto main = main_tab->add_tab("carry.shyvana.main", "Main");
 
         // Hotkeys - X (0x58) by default
@@ -238,6 +263,8 @@ namespace shyvana
         Permashow::Instance.AddElement("E Hitchance", settings::e_hitchance);
 
         event_handler<events::on_update>::add_callback(on_update);
+        event_handler<events::on_buff_gain>::add_callback(on_buff_gain);
+        event_handler<events::on_buff_lose>::add_callback(on_buff_lose);
 
         console->print("Shyvana plugin loaded!");
     }
@@ -247,6 +274,8 @@ namespace shyvana
         if (main_tab) menu->delete_tab(main_tab);
         if (e) plugin_sdk->remove_spell(e);
         event_handler<events::on_update>::remove_handler(on_update);
+        event_handler<events::on_buff_gain>::remove_handler(on_buff_gain);
+        event_handler<events::on_buff_lose>::remove_handler(on_buff_lose);
         console->print("Shyvana plugin unloaded!");
     }
 }
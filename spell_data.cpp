@@ -0,0 +1,30 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+#include "spell_data.h"
+#include <vector>
+
+namespace spell_data
+{
+    std::vector<collisionable_objects> collision_list(unsigned collision)
+    {
+        std::vector<collisionable_objects> list;
+        if (collision & COLLIDE_MINIONS) list.push_back(collisionable_objects::minions);
+        if (collision & COLLIDE_HEROES) list.push_back(collisionable_objects::heroes);
+        if (collision & COLLIDE_WINDWALL) list.push_back(collisionable_objects::yasuo_wall);
+        return list;
+    }
+
+    void apply_skillshot(script_spell* spell, const spell_desc& desc)
+    {
+        if (!spell || !desc.skillshot)
+            return;
+
+        spell->set_skillshot(desc.delay, desc.width, desc.speed, collision_list(desc.collision), desc.type);
+    }
+
+    script_spell* register_spell(const spell_desc& desc)
+    {
+        auto spell = plugin_sdk->register_spell(desc.slot, desc.range);
+        apply_skillshot(spell, desc);
+        return spell;
+    }
+}
@@ -0,0 +1,84 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+
+#pragma once
+namespace spell_data
+{
+    // Collision flags, kept as a bitmask so descriptors stay constexpr
+    //
+    enum collision_flags : unsigned
+    {
+        COLLIDE_NONE = 0,
+        COLLIDE_MINIONS = 1 << 0,
+        COLLIDE_HEROES = 1 << 1,
+        COLLIDE_WINDWALL = 1 << 2
+    };
+
+    // One entry per spell slot. Targeted and self-cast spells leave the skillshot fields zeroed.
+    //
+    struct spell_desc
+    {
+        spellslot slot;
+        float range;
+        float delay;
+        float width;
+        float speed;
+        unsigned collision;
+        skillshot_type type;
+        bool skillshot;
+        float aoe_radius;
+    };
+
+    constexpr spell_desc targeted(spellslot slot, float range, float aoe_radius = 0.0f)
+    {
+        return { slot, range, 0.0f, 0.0f, 0.0f, COLLIDE_NONE, skillshot_type::skillshot_line, false, aoe_radius };
+    }
+
+    constexpr spell_desc skillshot(spellslot slot, float range, float delay, float width, float speed,
+        unsigned collision, skillshot_type type, float aoe_radius = 0.0f)
+    {
+        return { slot, range, delay, width, speed, collision, type, true, aoe_radius };
+    }
+
+    // Registration
+    //
+    script_spell* register_spell(const spell_desc& desc);
+    void apply_skillshot(script_spell* spell, const spell_desc& desc);
+    std::vector<collisionable_objects> collision_list(unsigned collision);
+
+    // Per-champion tables
+    //
+    namespace kennen
+    {
+        constexpr spell_desc Q = skillshot(spellslot::q, 1050.0f, 0.175f, 70.0f, 1700.0f,
+            COLLIDE_MINIONS | COLLIDE_HEROES, skillshot_type::skillshot_line, 140.0f);
+        constexpr spell_desc W = targeted(spellslot::w, 750.0f);
+        constexpr spell_desc E = targeted(spellslot::e, 750.0f);
+        constexpr spell_desc R = targeted(spellslot::r, 550.0f, 550.0f);
+    }
+
+    namespace shyvana
+    {
+        constexpr spell_desc E = skillshot(spellslot::e, 925.0f, 0.25f, 120.0f, 1600.0f,
+            COLLIDE_MINIONS | COLLIDE_HEROES, skillshot_type::skillshot_line);
+        constexpr spell_desc E_DRAGON = skillshot(spellslot::e, 925.0f, 0.3333f, 345.0f, 1575.0f,
+            COLLIDE_MINIONS | COLLIDE_HEROES, skillshot_type::skillshot_line, 345.0f);
+    }
+
+    namespace zed
+    {
+        constexpr spell_desc Q = skillshot(spellslot::q, 900.0f, 0.25f, 50.0f, 1700.0f,
+            COLLIDE_HEROES | COLLIDE_WINDWALL | COLLIDE_MINIONS, skillshot_type::skillshot_line);
+        constexpr spell_desc W = targeted(spellslot::w, 700.0f);
+        constexpr spell_desc E = targeted(spellslot::e, 300.0f, 300.0f);
+        constexpr spell_desc R = targeted(spellslot::r, 625.0f);
+    }
+
+    namespace zilean
+    {
+        constexpr spell_desc Q = skillshot(spellslot::q, 900.0f, 0.28f, 150.0f, 1100.0f,
+            COLLIDE_NONE, skillshot_type::skillshot_circle, 150.0f);
+        constexpr spell_desc W = targeted(spellslot::w, 700.0f);
+        constexpr spell_desc E = targeted(spellslot::e, 550.0f);
+        constexpr spell_desc R = targeted(spellslot::r, 900.0f);
+    }
+};
@@ -0,0 +1,228 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+#include "telemetry.h"
+#include "utils.h"
+#include "watchdog.h"
+#include "alloc_counter.h"
+#include "waves.h"
+#include <array>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <algorithm>
+
+// Override from the build to tell builds apart in the report, e.g. the git commit
+#ifndef LUVVY_BUILD_ID
+#define LUVVY_BUILD_ID __DATE__ " " __TIME__
+#endif
+
+namespace telemetry
+{
+    using telemetry_format::file_header;
+    using telemetry_format::tick_record;
+
+    constexpr std::size_t RING_SIZE = 1024; // power of two
+    constexpr auto WRITER_INTERVAL = std::chrono::milliseconds(100);
+
+    // Single producer (game thread), single consumer (writer thread)
+    static std::array<tick_record, RING_SIZE> ring;
+    static std::atomic<std::size_t> head{ 0 };
+    static std::atomic<std::size_t> tail{ 0 };
+    static std::atomic<std::uint64_t> dropped{ 0 };
+
+    // Module names are string literals owned by the watchdog; the count is published after the names
+    static const char* module_names[telemetry_format::MAX_MODULES] = {};
+    static std::atomic<int> module_count{ 0 };
+
+    static std::atomic<bool> active{ false };
+    static std::atomic<bool> running{ false };
+    static std::thread writer;
+    static std::string champion_name;
+    static std::chrono::steady_clock::time_point session_clock;
+
+    std::string slot_path(int slot)
+    {
+        return "luvvy_telemetry." + std::to_string(slot) + ".bin";
+    }
+
+    // First missing or foreign slot, otherwise the one holding the oldest segment
+    int pick_slot()
+    {
+        int oldest = 0;
+        file_header oldest_header;
+        oldest_header.session_start = INT64_MAX;
+        for (int slot = 0; slot < MAX_FILES; ++slot)
+        {
+            file_header header;
+            std::FILE* file = std::fopen(slot_path(slot).c_str(), "rb");
+            bool valid = file && std::fread(&header, sizeof(header), 1, file) == 1 && header.magic == telemetry_format::MAGIC;
+            if (file)
+                std::fclose(file);
+            if (!valid)
+                return slot;
+
+            if (header.session_start < oldest_header.session_start ||
+                (header.session_start == oldest_header.session_start && header.segment < oldest_header.segment))
+            {
+                oldest = slot;
+                oldest_header = header;
+            }
+        }
+        return oldest;
+    }
+
+    void write_header(std::FILE* file, file_header& header)
+    {
+        int count = std::min(module_count.load(std::memory_order_acquire), telemetry_format::MAX_MODULES);
+        for (int i = static_cast<int>(header.module_count); i < count; ++i)
+            std::snprintf(header.modules[i], sizeof(header.modules[i]), "%s", module_names[i] ? module_names[i] : "?");
+        header.module_count = static_cast<std::uint32_t>(count);
+
+        std::fseek(file, 0, SEEK_SET);
+        std::fwrite(&header, sizeof(header), 1, file);
+        std::fseek(file, 0, SEEK_END);
+    }
+
+    std::FILE* open_segment(file_header& header)
+    {
+        std::FILE* file = std::fopen(slot_path(pick_slot()).c_str(), "wb");
+        if (file)
+        {
+            header.module_count = 0;
+            std::memset(header.modules, 0, sizeof(header.modules));
+            write_header(file, header);
+        }
+        return file;
+    }
+
+    void writer_loop()
+    {
+        file_header header;
+        header.record_size = sizeof(tick_record);
+        header.session_start = static_cast<std::int64_t>(std::time(nullptr));
+        std::snprintf(header.build, sizeof(header.build), "%s", LUVVY_BUILD_ID);
+        std::snprintf(header.champion, sizeof(header.champion), "%s", champion_name.c_str());
+
+        std::FILE* file = nullptr;
+        while (true)
+        {
+            bool stopping = !running.load(std::memory_order_acquire);
+
+            auto t = tail.load(std::memory_order_relaxed);
+            auto h = head.load(std::memory_order_acquire);
+            // Nothing is created on disk until the first record arrives
+            if (!file && t != h)
+                file = open_segment(header);
+            if (file && static_cast<int>(header.module_count) != module_count.load(std::memory_order_acquire))
+                write_header(file, header);
+            for (; t != h; ++t)
+            {
+                if (file)
+                    std::fwrite(&ring[t & (RING_SIZE - 1)], sizeof(tick_record), 1, file);
+            }
+            tail.store(t, std::memory_order_release);
+
+            if (file)
+            {
+                std::fflush(file);
+                if (std::ftell(file) > MAX_FILE_BYTES)
+                {
+                    std::fclose(file);
+                    ++header.segment;
+                    file = open_segment(header);
+                }
+            }
+
+            if (stopping)
+                break;
+            std::this_thread::sleep_for(WRITER_INTERVAL);
+        }
+
+        if (file)
+            std::fclose(file);
+    }
+
+    void start(const std::string& champion)
+    {
+        if (running.exchange(true))
+            return;
+        champion_name = champion;
+        session_clock = std::chrono::steady_clock::now();
+        writer = std::thread(writer_loop);
+    }
+
+    void stop()
+    {
+        active.store(false, std::memory_order_relaxed);
+        if (!running.exchange(false))
+            return;
+        if (writer.joinable())
+            writer.join();
+    }
+
+    void set_active(bool value)
+    {
+        active.store(value, std::memory_order_relaxed);
+    }
+
+    bool is_active()
+    {
+        return active.load(std::memory_order_relaxed);
+    }
+
+    void record_tick()
+    {
+        if (!active.load(std::memory_order_relaxed))
+            return;
+
+        auto h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) >= RING_SIZE)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        auto& rec = ring[h & (RING_SIZE - 1)];
+        rec = tick_record{};
+        rec.tick = utils::get_tick() - 1;
+        rec.timestamp_ns = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - session_clock).count());
+        rec.game_time = gametime->get_time();
+
+        int count = 0;
+        auto modules = watchdog::get_modules(&count);
+        count = std::min(count, telemetry_format::MAX_MODULES);
+        for (int i = 0; i < count; ++i)
+        {
+            rec.module_ns[i] = static_cast<std::uint32_t>(modules[i].last_ms * 1000000.0f);
+            rec.total_ns += rec.module_ns[i];
+        }
+        int known = module_count.load(std::memory_order_relaxed);
+        if (count > known)
+        {
+            for (int i = known; i < count; ++i)
+                module_names[i] = modules[i].name;
+            module_count.store(count, std::memory_order_release);
+        }
+
+        auto allocations = alloc_counter::get_last_tick();
+        rec.allocations = static_cast<std::uint32_t>(allocations.allocations);
+        rec.allocated_bytes = static_cast<std::uint32_t>(allocations.bytes);
+
+        int clusters = 0;
+        waves::get_clusters(&clusters);
+        rec.enemy_minions = static_cast<std::uint16_t>(entitylist->get_enemy_minions().size());
+        rec.jungle_mobs = static_cast<std::uint16_t>(entitylist->get_jugnle_mobs_minions().size());
+        rec.wave_clusters = static_cast<std::uint16_t>(clusters);
+        rec.heroes = static_cast<std::uint8_t>(entitylist->get_enemy_heroes().size() + entitylist->get_ally_heroes().size());
+        rec.watchdog_level = static_cast<std::uint8_t>(watchdog::get_level());
+
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    std::uint64_t dropped_count()
+    {
+        return dropped.load(std::memory_order_relaxed);
+    }
+}
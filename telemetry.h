@@ -0,0 +1,26 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+#include "telemetry_format.h"
+#include <string>
+
+#pragma once
+namespace telemetry
+{
+    // Files rotate through MAX_FILES slots, so at most MAX_FILES * MAX_FILE_BYTES stay on disk
+    constexpr long MAX_FILE_BYTES = 16 * 1024 * 1024;
+    constexpr int MAX_FILES = 8;
+
+    // Writer lifetime, records are written on a background thread like the logger's
+    //
+    void start(const std::string& champion);
+    void stop();
+
+    // Recording is off until enabled from Developer Settings
+    //
+    void set_active(bool value);
+    bool is_active();
+
+    // Closes the previous tick into one record, called from the frame start callback after the
+    // watchdog and allocation accounting ran
+    void record_tick();
+    std::uint64_t dropped_count();
+};
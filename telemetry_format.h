@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+
+// On-disk layout of the tick telemetry files. Shared with tools/telemetry_report.cpp, so this header
+// must stay free of the SDK. A file is one file_header followed by tightly packed tick_records; the
+// header is rewritten in place when new modules show up, records are only ever appended.
+namespace telemetry_format
+{
+    constexpr std::uint32_t MAGIC = 0x4C54564C; // "LVTL"
+    constexpr std::uint32_t VERSION = 1;
+    constexpr int MAX_MODULES = 16;
+    constexpr int NAME_SIZE = 32;
+
+    struct file_header
+    {
+        std::uint32_t magic = MAGIC;
+        std::uint32_t version = VERSION;
+        std::uint32_t header_size = sizeof(file_header);
+        std::uint32_t record_size = 0;
+        // Wall clock at session start (unix seconds), segments of one session share it
+        std::int64_t session_start = 0;
+        std::uint32_t segment = 0;
+        std::uint32_t module_count = 0;
+        char build[NAME_SIZE] = {};
+        char champion[NAME_SIZE] = {};
+        // Index i names module_ns[i] in every record of this file
+        char modules[MAX_MODULES][NAME_SIZE] = {};
+    };
+
+    struct tick_record
+    {
+        std::uint64_t tick = 0;
+        // Steady clock since session start
+        std::uint64_t timestamp_ns = 0;
+        float game_time = 0.0f;
+        std::uint32_t total_ns = 0;
+        std::uint32_t allocations = 0;
+        std::uint32_t allocated_bytes = 0;
+        std::uint16_t enemy_minions = 0;
+        std::uint16_t jungle_mobs = 0;
+        std::uint16_t wave_clusters = 0;
+        std::uint8_t heroes = 0;
+        std::uint8_t watchdog_level = 0;
+        std::uint32_t module_ns[MAX_MODULES] = {};
+    };
+
+    static_assert(sizeof(file_header) % 8 == 0, "records must stay 8-byte aligned when mapped");
+    static_assert(sizeof(tick_record) % 8 == 0, "records must stay 8-byte aligned when mapped");
+}
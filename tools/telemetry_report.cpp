@@ -0,0 +1,284 @@
+// Offline report over tick telemetry files written by the plugin (see telemetry_format.h).
+//
+//   g++ -std=c++17 -O2 -o telemetry_report tools/telemetry_report.cpp
+//   ./telemetry_report [--worst N] [--threshold PCT] [--base BUILD --new BUILD] luvvy_telemetry.*.bin ...
+//
+// Files are memory-mapped and grouped by the build id in their header. Prints tick time percentiles
+// per build and module, the worst ticks with their entity counts, and a regression table between
+// two builds (by default the oldest and the newest build seen).
+#include "../telemetry_format.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using telemetry_format::file_header;
+    using telemetry_format::tick_record;
+
+    struct mapped_file
+    {
+        std::string path;
+        const file_header* header = nullptr;
+        const tick_record* records = nullptr;
+        std::size_t count = 0;
+        void* base = nullptr;
+        std::size_t size = 0;
+    };
+
+    // Module times are re-keyed by name, module slots differ between sessions
+    struct build_stats
+    {
+        std::string build;
+        std::int64_t first_session = INT64_MAX;
+        std::set<std::pair<std::int64_t, std::string>> sessions;
+        std::vector<std::uint32_t> total_ns;
+        std::map<std::string, std::vector<std::uint32_t>> module_ns;
+        // (total_ns, file index, record index)
+        std::vector<std::pair<std::uint32_t, std::pair<std::size_t, std::size_t>>> ticks;
+    };
+
+    struct percentiles
+    {
+        double p50 = 0.0, p90 = 0.0, p95 = 0.0, p99 = 0.0, max = 0.0;
+        std::size_t samples = 0;
+    };
+
+    bool map_file(const char* path, mapped_file& out)
+    {
+        int fd = open(path, O_RDONLY);
+        if (fd < 0)
+        {
+            std::fprintf(stderr, "%s: cannot open\n", path);
+            return false;
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(file_header))
+        {
+            std::fprintf(stderr, "%s: too small\n", path);
+            close(fd);
+            return false;
+        }
+
+        void* base = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED)
+        {
+            std::fprintf(stderr, "%s: mmap failed\n", path);
+            return false;
+        }
+
+        auto header = static_cast<const file_header*>(base);
+        if (header->magic != telemetry_format::MAGIC || header->version != telemetry_format::VERSION ||
+            header->header_size != sizeof(file_header) || header->record_size != sizeof(tick_record))
+        {
+            std::fprintf(stderr, "%s: not a telemetry file of this version\n", path);
+            munmap(base, st.st_size);
+            return false;
+        }
+
+        out.path = path;
+        out.base = base;
+        out.size = st.st_size;
+        out.header = header;
+        out.records = reinterpret_cast<const tick_record*>(static_cast<const char*>(base) + header->header_size);
+        // A record cut off by a crash is ignored
+        out.count = (out.size - header->header_size) / header->record_size;
+        return true;
+    }
+
+    std::string field(const char* text, std::size_t size)
+    {
+        return std::string(text, strnlen(text, size));
+    }
+
+    percentiles compute(std::vector<std::uint32_t>& values)
+    {
+        percentiles p;
+        p.samples = values.size();
+        if (values.empty())
+            return p;
+
+        std::sort(values.begin(), values.end());
+        auto at = [&values](double q) {
+            return values[static_cast<std::size_t>(q * (values.size() - 1))] / 1e6;
+        };
+        p.p50 = at(0.50);
+        p.p90 = at(0.90);
+        p.p95 = at(0.95);
+        p.p99 = at(0.99);
+        p.max = values.back() / 1e6;
+        return p;
+    }
+
+    void print_row(const char* name, const percentiles& p)
+    {
+        std::printf("  %-28s %9zu %8.3f %8.3f %8.3f %8.3f %8.3f\n", name, p.samples, p.p50, p.p90, p.p95, p.p99, p.max);
+    }
+
+    void print_build(build_stats& stats, const std::vector<mapped_file>& files, std::size_t worst)
+    {
+        std::printf("build %s: %zu sessions, %zu ticks\n", stats.build.c_str(), stats.sessions.size(), stats.total_ns.size());
+        std::printf("  %-28s %9s %8s %8s %8s %8s %8s\n", "ms", "samples", "p50", "p90", "p95", "p99", "max");
+
+        auto total_copy = stats.total_ns;
+        print_row("total", compute(total_copy));
+        for (auto& entry : stats.module_ns)
+        {
+            auto copy = entry.second;
+            print_row(entry.first.c_str(), compute(copy));
+        }
+
+        std::size_t shown = std::min(worst, stats.ticks.size());
+        std::partial_sort(stats.ticks.begin(), stats.ticks.begin() + shown, stats.ticks.end(),
+            [](const auto& a, const auto& b) { return a.first > b.first; });
+
+        std::printf("  worst ticks:\n");
+        for (std::size_t i = 0; i < shown; ++i)
+        {
+            auto& file = files[stats.ticks[i].second.first];
+            auto& rec = file.records[stats.ticks[i].second.second];
+
+            int worst_module = -1;
+            for (std::uint32_t m = 0; m < file.header->module_count; ++m)
+            {
+                if (worst_module < 0 || rec.module_ns[m] > rec.module_ns[worst_module])
+                    worst_module = static_cast<int>(m);
+            }
+
+            std::printf("    %8.3f ms  %-10s t=%7.1fs tick %-8llu minions %3u mobs %2u waves %2u heroes %2u level %u allocs %u  worst %s  (%s)\n",
+                rec.total_ns / 1e6, field(file.header->champion, sizeof(file.header->champion)).c_str(),
+                rec.game_time, static_cast<unsigned long long>(rec.tick), rec.enemy_minions, rec.jungle_mobs,
+                rec.wave_clusters, rec.heroes, rec.watchdog_level, rec.allocations,
+                worst_module >= 0 ? field(file.header->modules[worst_module], sizeof(file.header->modules[worst_module])).c_str() : "-",
+                file.path.c_str());
+        }
+        std::printf("\n");
+    }
+
+    // Compared at p50/p95/p99; a metric regresses when its p95 grew by more than `threshold` percent
+    int print_regressions(build_stats& base, build_stats& next, double threshold)
+    {
+        std::printf("regressions %s -> %s (p95 threshold %.0f%%)\n", base.build.c_str(), next.build.c_str(), threshold);
+        std::printf("  %-28s %17s %17s %17s\n", "ms", "p50", "p95", "p99");
+
+        int regressed = 0;
+        auto row = [&](const char* name, std::vector<std::uint32_t> a, std::vector<std::uint32_t> b) {
+            if (a.empty() || b.empty())
+                return;
+            auto pa = compute(a);
+            auto pb = compute(b);
+            bool worse = pa.p95 > 0.0 && (pb.p95 - pa.p95) / pa.p95 * 100.0 > threshold;
+            regressed += worse ? 1 : 0;
+            std::printf("  %-28s %7.3f -> %7.3f %7.3f -> %7.3f %7.3f -> %7.3f%s\n", name,
+                pa.p50, pb.p50, pa.p95, pb.p95, pa.p99, pb.p99, worse ? "  REGRESSED" : "");
+        };
+
+        row("total", base.total_ns, next.total_ns);
+        for (auto& entry : next.module_ns)
+        {
+            auto it = base.module_ns.find(entry.first);
+            if (it != base.module_ns.end())
+                row(entry.first.c_str(), it->second, entry.second);
+        }
+        return regressed;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t worst = 10;
+    double threshold = 10.0;
+    std::string base_build;
+    std::string next_build;
+    std::vector<mapped_file> files;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "--worst") && i + 1 < argc)
+            worst = std::strtoul(argv[++i], nullptr, 10);
+        else if (!std::strcmp(argv[i], "--threshold") && i + 1 < argc)
+            threshold = std::strtod(argv[++i], nullptr);
+        else if (!std::strcmp(argv[i], "--base") && i + 1 < argc)
+            base_build = argv[++i];
+        else if (!std::strcmp(argv[i], "--new") && i + 1 < argc)
+            next_build = argv[++i];
+        else
+        {
+            mapped_file file;
+            if (map_file(argv[i], file))
+                files.push_back(file);
+        }
+    }
+
+    if (files.empty())
+    {
+        std::fprintf(stderr, "usage: %s [--worst N] [--threshold PCT] [--base BUILD --new BUILD] files...\n", argv[0]);
+        return 2;
+    }
+
+    std::map<std::string, build_stats> builds;
+    for (std::size_t f = 0; f < files.size(); ++f)
+    {
+        auto& file = files[f];
+        auto build = field(file.header->build, sizeof(file.header->build));
+        auto& stats = builds[build];
+        stats.build = build;
+        stats.first_session = std::min<std::int64_t>(stats.first_session, file.header->session_start);
+        stats.sessions.insert({ file.header->session_start, field(file.header->champion, sizeof(file.header->champion)) });
+
+        std::uint32_t module_count = std::min<std::uint32_t>(file.header->module_count, telemetry_format::MAX_MODULES);
+        std::vector<std::vector<std::uint32_t>*> columns(module_count);
+        for (std::uint32_t m = 0; m < module_count; ++m)
+            columns[m] = &stats.module_ns[field(file.header->modules[m], sizeof(file.header->modules[m]))];
+
+        for (std::size_t r = 0; r < file.count; ++r)
+        {
+            auto& rec = file.records[r];
+            stats.total_ns.push_back(rec.total_ns);
+            stats.ticks.push_back({ rec.total_ns, { f, r } });
+            for (std::uint32_t m = 0; m < module_count; ++m)
+                columns[m]->push_back(rec.module_ns[m]);
+        }
+    }
+
+    std::vector<build_stats*> ordered;
+    for (auto& entry : builds)
+        ordered.push_back(&entry.second);
+    std::sort(ordered.begin(), ordered.end(), [](const build_stats* a, const build_stats* b) {
+        return a->first_session < b->first_session;
+    });
+
+    for (auto stats : ordered)
+        print_build(*stats, files, worst);
+
+    int regressed = 0;
+    if (ordered.size() >= 2 || (!base_build.empty() && !next_build.empty()))
+    {
+        auto base = base_build.empty() ? ordered.front() : (builds.count(base_build) ? &builds[base_build] : nullptr);
+        auto next = next_build.empty() ? ordered.back() : (builds.count(next_build) ? &builds[next_build] : nullptr);
+        if (!base || !next)
+        {
+            std::fprintf(stderr, "unknown build for --base/--new\n");
+            return 2;
+        }
+        regressed = print_regressions(*base, *next, threshold);
+    }
+
+    for (auto& file : files)
+        munmap(file.base, file.size);
+
+    // Non-zero exit lets a script gate on regressions
+    return regressed > 0 ? 1 : 0;
+}
@@ -0,0 +1,530 @@
+// Offline menu value sweep over tuner corpora written by the plugin (see tuner_format.h).
+//
+//   g++ -std=c++17 -O2 -pthread -o tuner tools/tuner.cpp
+//   ./tuner [--threads N] [--random N] [--seed S] [--top N] luvvy_tuner.*.bin ...
+//
+// Samples are grouped by champion and decision, and every menu value the decision reads is swept over
+// its slider range (or N random picks of it). Each worker thread replays the whole group for one
+// configuration at a time. Configurations are ranked by labelled outcomes; unknown outcomes are counted
+// but never score. Only what was recorded can be replayed: settings looser than the recording ones see
+// no extra casts, and farm kills only exist where we actually cast, so record with loose settings.
+#include "../tuner_format.h"
+#include "../circle_scoring.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+    using namespace tuner_format;
+
+    // spellslot and hit_chance values of the SDK
+    constexpr int SLOT_Q = 0;
+    constexpr int SLOT_E = 2;
+    constexpr int HITCHANCE_LOW = 3;
+
+    // A cast that kills nothing costs about one kill worth of mana and cooldown
+    constexpr float WASTE_PENALTY = 1.0f;
+    constexpr float MISS_PENALTY = 1.0f;
+    constexpr float ULT_WASTE_PENALTY = 0.5f;
+    // A kill is worth about half of our HP; deaths shortly after the swap still count
+    constexpr float HP_PER_KILL = 50.0f;
+    constexpr float SWAP_KILL_GRACE = 0.25f;
+    constexpr int MAX_PARAMS = 2;
+
+    struct mapped_file
+    {
+        std::string path;
+        const file_header* header = nullptr;
+        const sample* samples = nullptr;
+        std::size_t count = 0;
+        void* base = nullptr;
+        std::size_t size = 0;
+    };
+
+    struct param
+    {
+        const char* name;
+        int lo;
+        int hi;
+        int step;
+    };
+
+    struct config
+    {
+        int values[MAX_PARAMS] = {};
+    };
+
+    struct result
+    {
+        config cfg;
+        int decisions = 0;
+        int good = 0;
+        int bad = 0;
+        int unknown = 0;
+        float score = 0.0f;
+    };
+
+    struct sweep
+    {
+        std::string champion;
+        sample_kind kind = sample_kind::farm;
+        int slot = -1;
+        std::vector<const sample*> samples;
+        // Ult samples only: (file index << 32 | episode), episode ids restart in every recording
+        std::vector<std::uint64_t> episodes;
+        param params[MAX_PARAMS] = {};
+        int param_count = 0;
+        const char* decision_label = "casts";
+        const char* good_label = "good";
+        const char* bad_label = "bad";
+    };
+
+    bool map_file(const char* path, mapped_file& out)
+    {
+        int fd = open(path, O_RDONLY);
+        if (fd < 0)
+        {
+            std::fprintf(stderr, "%s: cannot open\n", path);
+            return false;
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(file_header))
+        {
+            std::fprintf(stderr, "%s: too small\n", path);
+            close(fd);
+            return false;
+        }
+
+        void* base = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED)
+        {
+            std::fprintf(stderr, "%s: mmap failed\n", path);
+            return false;
+        }
+
+        auto header = static_cast<const file_header*>(base);
+        if (header->magic != MAGIC || header->version != VERSION ||
+            header->header_size != sizeof(file_header) || header->record_size != sizeof(sample))
+        {
+            std::fprintf(stderr, "%s: not a tuner file of this version\n", path);
+            munmap(base, st.st_size);
+            return false;
+        }
+
+        out.path = path;
+        out.base = base;
+        out.size = st.st_size;
+        out.header = header;
+        out.samples = reinterpret_cast<const sample*>(static_cast<const char*>(base) + header->header_size);
+        // A sample cut off by a crash is ignored
+        out.count = (out.size - header->header_size) / header->record_size;
+        return true;
+    }
+
+    std::string lower(std::string text)
+    {
+        std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return text;
+    }
+
+    // Menu values each decision reads, named like the menu entries
+    void describe(sweep& s)
+    {
+        auto champion = lower(s.champion);
+        switch (s.kind)
+        {
+            case sample_kind::farm:
+                s.decision_label = "casts";
+                s.good_label = "kills";
+                s.bad_label = "wasted";
+                if (champion == "zilean" && s.slot == SLOT_Q)
+                    s.params[0] = { "farm_qwq_min", 2, 12, 1 };
+                else if (champion == "shyvana" && s.slot == SLOT_E)
+                    s.params[0] = { "minions_hit", 1, 6, 1 };
+                else
+                    s.params[0] = { "min_hits", 1, 8, 1 };
+                s.param_count = 1;
+                break;
+
+            case sample_kind::skillshot:
+                s.decision_label = "casts";
+                s.good_label = "hits";
+                s.bad_label = "misses";
+                s.params[0] = { s.slot == SLOT_E ? "e_hitchance" : "q_hitchance", 0, 3, 1 };
+                s.param_count = 1;
+                if (champion == "zilean" && s.slot == SLOT_Q)
+                    s.params[s.param_count++] = { "safe_q_range_slider", 30, 100, 5 };
+                break;
+
+            case sample_kind::ult:
+                s.decision_label = "ults";
+                s.good_label = "saves";
+                s.bad_label = "wasted";
+                s.params[0] = { "r_min_hp", 1, 70, 1 };
+                s.param_count = 1;
+                break;
+
+            case sample_kind::swap_back:
+                s.decision_label = "all-ins";
+                s.good_label = "kills";
+                s.bad_label = "hp lost";
+                s.params[0] = { "combo_swap_back_delay", 1, 20, 1 };
+                s.param_count = 1;
+                break;
+        }
+    }
+
+    // --- Replays, one per decision kind ---
+
+    void replay_farm(const sweep& s, result& r)
+    {
+        int min_hits = r.cfg.values[0];
+        circle_scoring::point units[MAX_MINIONS];
+        circle_scoring::point centers[MAX_CENTERS];
+        int counts[MAX_CENTERS];
+        float scores[MAX_CENTERS];
+
+        for (auto smp : s.samples)
+        {
+            const auto& farm = smp->farm;
+            for (int i = 0; i < farm.minion_count; ++i)
+                units[i] = { farm.minions[i].x, farm.minions[i].y, farm.minions[i].killable != 0 };
+            for (int i = 0; i < farm.center_count; ++i)
+                centers[i] = { farm.centers[i].x, farm.centers[i].y, false };
+
+            circle_scoring::score_range(centers, 0, farm.center_count, units, farm.minion_count, farm.radius, farm.kill_weight, counts, scores);
+            int pick = -1;
+            if (farm.policy == farm_policy::best_score)
+            {
+                pick = circle_scoring::pick_best(scores, farm.center_count);
+                if (pick >= 0 && counts[pick] < min_hits)
+                    pick = -1;
+            }
+            else
+            {
+                for (int i = 0; i < farm.center_count && pick < 0; ++i)
+                {
+                    if (counts[i] >= min_hits)
+                        pick = i;
+                }
+            }
+            if (pick < 0)
+                continue;
+
+            int kills = 0, unknown = 0;
+            float radius_sq = farm.radius * farm.radius;
+            for (int i = 0; i < farm.minion_count; ++i)
+            {
+                float dx = units[i].x - centers[pick].x, dy = units[i].y - centers[pick].y;
+                if (dx * dx + dy * dy > radius_sq)
+                    continue;
+                if (farm.minions[i].outcome == minion_outcome::killed_by_us)
+                    kills++;
+                else if (farm.minions[i].outcome == minion_outcome::unknown)
+                    unknown++;
+            }
+
+            r.decisions++;
+            r.good += kills;
+            if (kills == 0 && unknown == 0)
+                r.bad++;
+            else if (kills == 0)
+                r.unknown++;
+        }
+        r.score = r.good - WASTE_PENALTY * r.bad;
+    }
+
+    void replay_skillshot(const sweep& s, result& r)
+    {
+        int minimum = HITCHANCE_LOW + r.cfg.values[0];
+        float max_range = s.param_count > 1 ? static_cast<float>(r.cfg.values[1]) : 1e9f;
+        for (auto smp : s.samples)
+        {
+            const auto& shot = smp->skillshot;
+            if (shot.hitchance < minimum || shot.range_percent > max_range)
+                continue;
+
+            r.decisions++;
+            if (shot.outcome == cast_outcome::hit)
+                r.good++;
+            else if (shot.outcome == cast_outcome::miss)
+                r.bad++;
+            else
+                r.unknown++;
+        }
+        r.score = r.good - MISS_PENALTY * r.bad;
+    }
+
+    // Samples are sorted by episode; the first look that would fire decides the episode, since R
+    // is not back in time for a second one
+    void replay_ult(const sweep& s, result& r)
+    {
+        float min_hp = static_cast<float>(r.cfg.values[0]);
+        std::size_t i = 0;
+        while (i < s.samples.size())
+        {
+            std::uint64_t episode = s.episodes[i];
+            const sample* fired = nullptr;
+            for (; i < s.samples.size() && s.episodes[i] == episode; ++i)
+            {
+                const auto& ult = s.samples[i]->ult;
+                float score = std::max(ult.other_score, min_hp / std::max(ult.hp_percent, 0.01f));
+                if (!fired && score > 1.0f)
+                    fired = s.samples[i];
+            }
+            if (!fired)
+                continue;
+
+            r.decisions++;
+            if (fired->ult.outcome == ally_outcome::died)
+                r.good++;
+            else if (fired->ult.outcome == ally_outcome::survived)
+                r.bad++;
+            else
+                r.unknown++;
+        }
+        r.score = r.good - ULT_WASTE_PENALTY * r.bad;
+    }
+
+    // HP past the recorded swap back was never observed, those all-ins are unknown for longer delays
+    void replay_swap(const sweep& s, result& r)
+    {
+        float delay = r.cfg.values[0] * 0.1f;
+        float hp_lost = 0.0f;
+        for (auto smp : s.samples)
+        {
+            const auto& swap = smp->swap;
+            r.decisions++;
+            float swap_at = std::max(delay, swap.earliest_swap);
+            int step = static_cast<int>(std::ceil(swap_at / SWAP_TRACE_STEP - 1e-4f));
+            if (!swap.target_known || swap.trace_count == 0 || (step >= swap.trace_count && swap.trace_count < SWAP_TRACE))
+            {
+                r.unknown++;
+                continue;
+            }
+
+            step = std::min(step, static_cast<int>(swap.trace_count) - 1);
+            hp_lost += std::max(0.0f, swap.hp_percent[0] - swap.hp_percent[step]);
+            if (swap.target_died_at >= 0.0f && swap.target_died_at <= swap_at + SWAP_KILL_GRACE)
+                r.good++;
+        }
+        r.bad = static_cast<int>(hp_lost + 0.5f);
+        r.score = r.good - hp_lost / HP_PER_KILL;
+    }
+
+    void replay(const sweep& s, result& r)
+    {
+        switch (s.kind)
+        {
+            case sample_kind::farm: replay_farm(s, r); break;
+            case sample_kind::skillshot: replay_skillshot(s, r); break;
+            case sample_kind::ult: replay_ult(s, r); break;
+            case sample_kind::swap_back: replay_swap(s, r); break;
+        }
+    }
+
+    std::vector<config> make_configs(const sweep& s, int random_count, std::mt19937& rng)
+    {
+        std::vector<config> configs;
+        if (random_count > 0)
+        {
+            for (int n = 0; n < random_count; ++n)
+            {
+                config c;
+                for (int p = 0; p < s.param_count; ++p)
+                {
+                    const auto& prm = s.params[p];
+                    std::uniform_int_distribution<int> pick(0, (prm.hi - prm.lo) / prm.step);
+                    c.values[p] = prm.lo + pick(rng) * prm.step;
+                }
+                configs.push_back(c);
+            }
+            return configs;
+        }
+
+        config c;
+        for (int p = 0; p < s.param_count; ++p)
+            c.values[p] = s.params[p].lo;
+        while (true)
+        {
+            configs.push_back(c);
+            int p = 0;
+            for (; p < s.param_count; ++p)
+            {
+                c.values[p] += s.params[p].step;
+                if (c.values[p] <= s.params[p].hi)
+                    break;
+                c.values[p] = s.params[p].lo;
+            }
+            if (p == s.param_count)
+                return configs;
+        }
+    }
+
+    const char* kind_name(sample_kind kind)
+    {
+        switch (kind)
+        {
+            case sample_kind::farm: return "farm";
+            case sample_kind::skillshot: return "skillshot";
+            case sample_kind::ult: return "ult";
+            case sample_kind::swap_back: return "swap back";
+        }
+        return "?";
+    }
+
+    const char* slot_name(int slot)
+    {
+        static const char* names[] = { "Q", "W", "E", "R" };
+        return slot >= 0 && slot < 4 ? names[slot] : "-";
+    }
+
+    // One configuration per worker at a time; returns replayed samples per second
+    double run_sweep(const sweep& s, std::vector<result>& results, int threads)
+    {
+        std::atomic<std::size_t> next{ 0 };
+        auto work = [&]()
+        {
+            for (std::size_t i = next.fetch_add(1); i < results.size(); i = next.fetch_add(1))
+                replay(s, results[i]);
+        };
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> pool;
+        int helpers = std::min<int>(threads, static_cast<int>(results.size())) - 1;
+        for (int t = 0; t < helpers; ++t)
+            pool.emplace_back(work);
+        work();
+        for (auto& thread : pool)
+            thread.join();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        double replayed = static_cast<double>(s.samples.size()) * results.size();
+        return seconds > 0.0 ? replayed / seconds : 0.0;
+    }
+
+    void print_sweep(const sweep& s, std::vector<result>& results, double samples_per_second, int threads, int top)
+    {
+        std::stable_sort(results.begin(), results.end(), [](const result& a, const result& b) { return a.score > b.score; });
+
+        std::printf("%s %s %s: %zu samples x %zu configs on %d thread(s), %.0f samples/sec\n", s.champion.c_str(),
+            kind_name(s.kind), slot_name(s.slot), s.samples.size(), results.size(), std::min<int>(threads, static_cast<int>(results.size())), samples_per_second);
+        for (int i = 0; i < top && i < static_cast<int>(results.size()); ++i)
+        {
+            const auto& r = results[i];
+            std::printf("  #%-2d", i + 1);
+            for (int p = 0; p < s.param_count; ++p)
+                std::printf(" %s %-4d", s.params[p].name, r.cfg.values[p]);
+            std::printf(" -> score %7.1f (%d %s, %d %s, %d %s, %d unknown)\n", r.score, r.decisions, s.decision_label,
+                r.good, s.good_label, r.bad, s.bad_label, r.unknown);
+        }
+        std::printf("\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    int random_count = 0;
+    unsigned seed = 1337;
+    int top = 5;
+    std::vector<mapped_file> files;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "--threads") && i + 1 < argc)
+            threads = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--random") && i + 1 < argc)
+            random_count = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc)
+            seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        else if (!std::strcmp(argv[i], "--top") && i + 1 < argc)
+            top = std::atoi(argv[++i]);
+        else
+        {
+            mapped_file file;
+            if (map_file(argv[i], file))
+                files.push_back(file);
+        }
+    }
+
+    if (files.empty())
+    {
+        std::fprintf(stderr, "usage: %s [--threads N] [--random N] [--seed S] [--top N] files...\n", argv[0]);
+        return 2;
+    }
+
+    std::map<std::tuple<std::string, int, int>, sweep> sweeps;
+    for (std::size_t f = 0; f < files.size(); ++f)
+    {
+        auto& file = files[f];
+        std::string champion(file.header->champion, strnlen(file.header->champion, sizeof(file.header->champion)));
+        for (std::size_t i = 0; i < file.count; ++i)
+        {
+            const auto& smp = file.samples[i];
+            if (smp.kind < sample_kind::farm || smp.kind > sample_kind::swap_back)
+                continue;
+            auto& s = sweeps[{ champion, static_cast<int>(smp.kind), smp.slot }];
+            s.champion = champion;
+            s.kind = smp.kind;
+            s.slot = smp.slot;
+            s.samples.push_back(&smp);
+            if (smp.kind == sample_kind::ult)
+                s.episodes.push_back(static_cast<std::uint64_t>(f) << 32 | smp.ult.episode);
+        }
+    }
+
+    std::mt19937 rng(seed);
+    for (auto& entry : sweeps)
+    {
+        auto& s = entry.second;
+        describe(s);
+        if (s.kind == sample_kind::ult)
+        {
+            std::vector<std::size_t> order(s.samples.size());
+            for (std::size_t i = 0; i < order.size(); ++i)
+                order[i] = i;
+            std::stable_sort(order.begin(), order.end(), [&s](std::size_t a, std::size_t b) { return s.episodes[a] < s.episodes[b]; });
+
+            std::vector<const sample*> samples(order.size());
+            std::vector<std::uint64_t> episodes(order.size());
+            for (std::size_t i = 0; i < order.size(); ++i)
+            {
+                samples[i] = s.samples[order[i]];
+                episodes[i] = s.episodes[order[i]];
+            }
+            s.samples.swap(samples);
+            s.episodes.swap(episodes);
+        }
+
+        auto configs = make_configs(s, random_count, rng);
+        std::vector<result> results(configs.size());
+        for (std::size_t i = 0; i < configs.size(); ++i)
+            results[i].cfg = configs[i];
+
+        double samples_per_second = run_sweep(s, results, threads);
+        print_sweep(s, results, samples_per_second, threads, top);
+    }
+
+    for (auto& file : files)
+        munmap(file.base, file.size);
+    return 0;
+}
@@ -0,0 +1,486 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+#include "tuner.h"
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+namespace tuner
+{
+    using namespace tuner_format;
+
+    // Minions move a little between the farm tick and their death
+    constexpr float DEATH_SLACK = 65.0f;
+    constexpr float ULT_RECORD_SCORE = 0.5f;
+    constexpr std::size_t RECENT_CASTS = 64;
+
+    struct pending_farm
+    {
+        sample data;
+        float impact_window = 0.0f;
+        float label_at = 0.0f;
+        utils::entity_handle handles[MAX_MINIONS];
+        // Negative until the minion is seen dead
+        float died_at[MAX_MINIONS];
+        vector died_pos[MAX_MINIONS];
+        bool lost[MAX_MINIONS];
+    };
+
+    struct pending_skillshot
+    {
+        sample data;
+        utils::entity_handle target;
+        std::uint32_t target_id = 0;
+        float label_at = 0.0f;
+    };
+
+    struct pending_ult
+    {
+        sample data;
+        utils::entity_handle ally;
+        std::uint32_t ally_id = 0;
+        float label_at = 0.0f;
+        bool died = false;
+        bool ulted = false;
+    };
+
+    struct ally_episode
+    {
+        std::uint32_t ally_id = 0;
+        std::uint32_t episode = 0;
+        float last_time = -1.0f;
+    };
+
+    struct recent_cast
+    {
+        spellslot slot = spellslot::invalid;
+        float x = 0.0f;
+        float y = 0.0f;
+        float time = -1.0f;
+    };
+
+    struct allin_state
+    {
+        bool active = false;
+        sample data;
+        utils::entity_handle target;
+        float start = 0.0f;
+        float swapped_at = -1.0f;
+        bool target_lost = false;
+    };
+
+    static bool recording = false;
+    static std::FILE* file = nullptr;
+    static std::int64_t session_start = 0;
+    static float last_farm_time = -1.0f;
+    static std::uint32_t next_episode = 0;
+
+    static std::vector<pending_farm> farms;
+    static std::vector<pending_skillshot> skillshots;
+    static std::vector<pending_ult> ults;
+    static std::vector<ally_episode> episodes;
+    static std::array<recent_cast, RECENT_CASTS> casts;
+    static std::size_t next_cast = 0;
+    static allin_state allin;
+
+    sample make_sample(sample_kind kind, spellslot slot)
+    {
+        sample s;
+        std::memset(&s, 0, sizeof(s));
+        s.kind = kind;
+        s.slot = static_cast<std::int8_t>(slot);
+        s.game_time = gametime->get_time();
+        return s;
+    }
+
+    void write(const sample& s)
+    {
+        if (!file)
+        {
+            file_header header;
+            header.record_size = sizeof(sample);
+            header.session_start = session_start;
+            std::snprintf(header.champion, sizeof(header.champion), "%s", myhero->get_model_cstr());
+
+            char path[128];
+            std::snprintf(path, sizeof(path), "luvvy_tuner.%s.%lld.bin", header.champion, static_cast<long long>(session_start));
+            file = std::fopen(path, "wb");
+            if (!file)
+            {
+                console->print("[luvvy] tuner: cannot open %s", path);
+                recording = false;
+                return;
+            }
+            std::fwrite(&header, sizeof(header), 1, file);
+        }
+        std::fwrite(&s, sizeof(s), 1, file);
+    }
+
+    // --- Labelling ---
+
+    bool killed_by_us(const pending_farm& farm, int i)
+    {
+        float sampled = farm.data.game_time;
+        float reach = farm.data.farm.radius + DEATH_SLACK;
+        for (const auto& cast : casts)
+        {
+            if (cast.time < sampled || cast.time > sampled + FARM_CAST_WINDOW || cast.slot != static_cast<spellslot>(farm.data.slot))
+                continue;
+            if (farm.died_at[i] < cast.time || farm.died_at[i] > cast.time + farm.impact_window)
+                continue;
+            if (farm.died_pos[i].distance(vector(cast.x, cast.y, farm.died_pos[i].z)) <= reach)
+                return true;
+        }
+        return false;
+    }
+
+    // Deaths are polled, dead units keep resolving until the object is deleted
+    void update_farms(float now)
+    {
+        for (size_t index = 0; index < farms.size();)
+        {
+            auto& farm = farms[index];
+            for (int i = 0; i < farm.data.farm.minion_count; ++i)
+            {
+                if (farm.died_at[i] >= 0.0f || farm.lost[i])
+                    continue;
+                auto minion = utils::resolve(farm.handles[i]);
+                if (!minion || !minion->is_visible())
+                    farm.lost[i] = true;
+                else if (minion->is_dead())
+                {
+                    farm.died_at[i] = now;
+                    farm.died_pos[i] = minion->get_position();
+                }
+            }
+
+            if (now < farm.label_at)
+            {
+                ++index;
+                continue;
+            }
+
+            for (int i = 0; i < farm.data.farm.minion_count; ++i)
+            {
+                auto& minion = farm.data.farm.minions[i];
+                if (farm.died_at[i] >= 0.0f)
+                    minion.outcome = killed_by_us(farm, i) ? minion_outcome::killed_by_us : minion_outcome::died_other;
+                else
+                    minion.outcome = farm.lost[i] ? minion_outcome::unknown : minion_outcome::alive;
+            }
+            write(farm.data);
+            if (index + 1 != farms.size())
+                farm = std::move(farms.back());
+            farms.pop_back();
+        }
+    }
+
+    void update_skillshots(float now)
+    {
+        for (size_t index = 0; index < skillshots.size();)
+        {
+            auto& shot = skillshots[index];
+            if (shot.data.skillshot.outcome != cast_outcome::hit && now < shot.label_at)
+            {
+                ++index;
+                continue;
+            }
+
+            if (shot.data.skillshot.outcome != cast_outcome::hit)
+            {
+                auto target = utils::resolve(shot.target);
+                bool seen = target && target->is_visible() && !target->is_dead();
+                shot.data.skillshot.outcome = seen ? cast_outcome::miss : cast_outcome::unknown;
+            }
+            write(shot.data);
+            if (index + 1 != skillshots.size())
+                shot = std::move(skillshots.back());
+            skillshots.pop_back();
+        }
+    }
+
+    void update_ults(float now)
+    {
+        for (size_t index = 0; index < ults.size();)
+        {
+            auto& ult = ults[index];
+            auto ally = utils::resolve(ult.ally);
+            if (ally && ally->is_dead())
+                ult.died = true;
+
+            if (now < ult.label_at)
+            {
+                ++index;
+                continue;
+            }
+
+            if (ult.ulted)
+                ult.data.ult.outcome = ally_outcome::unknown;
+            else
+                ult.data.ult.outcome = ult.died ? ally_outcome::died : ally_outcome::survived;
+            write(ult.data);
+            if (index + 1 != ults.size())
+                ult = std::move(ults.back());
+            ults.pop_back();
+        }
+    }
+
+    void finish_allin()
+    {
+        auto& swap = allin.data.swap;
+        swap.target_known = swap.target_died_at >= 0.0f || !allin.target_lost;
+        write(allin.data);
+        allin.active = false;
+    }
+
+    void update_allin(float now)
+    {
+        if (!allin.active)
+            return;
+
+        auto& swap = allin.data.swap;
+        float elapsed = now - allin.start;
+        while (allin.swapped_at < 0.0f && swap.trace_count < SWAP_TRACE && elapsed >= swap.trace_count * SWAP_TRACE_STEP)
+            swap.hp_percent[swap.trace_count++] = myhero->get_health_percent();
+
+        if (swap.target_died_at < 0.0f && !allin.target_lost)
+        {
+            auto target = utils::resolve(allin.target);
+            if (target && target->is_dead())
+                swap.target_died_at = elapsed;
+            else if (!target || !target->is_visible())
+                allin.target_lost = true;
+        }
+
+        if (elapsed >= SWAP_TRACE * SWAP_TRACE_STEP)
+            finish_allin();
+    }
+
+    void on_update()
+    {
+        if (!recording)
+            return;
+
+        float now = gametime->get_time();
+        update_farms(now);
+        update_skillshots(now);
+        update_ults(now);
+        update_allin(now);
+    }
+
+    void on_buff_gain(game_object_script sender, buff_instance_script buff)
+    {
+        if (!recording || skillshots.empty() || !sender || !buff || !buff->is_valid() || buff->get_caster() != myhero.get())
+            return;
+
+        float now = gametime->get_time();
+        auto id = sender->get_id();
+        for (auto& shot : skillshots)
+        {
+            if (shot.target_id == id && now <= shot.label_at)
+                shot.data.skillshot.outcome = cast_outcome::hit;
+        }
+    }
+
+    // --- Lifetime ---
+
+    void drop_pending()
+    {
+        farms.clear();
+        skillshots.clear();
+        ults.clear();
+        episodes.clear();
+        allin.active = false;
+        for (auto& cast : casts)
+            cast = recent_cast{};
+    }
+
+    void load()
+    {
+        event_handler<events::on_update>::add_callback(on_update);
+        event_handler<events::on_buff_gain>::add_callback(on_buff_gain);
+    }
+
+    void unload()
+    {
+        event_handler<events::on_update>::remove_handler(on_update);
+        event_handler<events::on_buff_gain>::remove_handler(on_buff_gain);
+        set_recording(false);
+        farms.shrink_to_fit();
+        skillshots.shrink_to_fit();
+        ults.shrink_to_fit();
+    }
+
+    // Samples still waiting for their label are dropped when recording stops
+    void set_recording(bool enabled)
+    {
+        if (enabled == recording)
+            return;
+
+        recording = enabled;
+        drop_pending();
+        if (recording)
+        {
+            session_start = static_cast<std::int64_t>(std::time(nullptr));
+            last_farm_time = -1.0f;
+            return;
+        }
+
+        if (file)
+        {
+            std::fclose(file);
+            file = nullptr;
+        }
+    }
+
+    bool is_recording()
+    {
+        return recording;
+    }
+
+    // --- Decision hooks ---
+
+    void record_farm(spellslot slot, const circle_scoring::point* units, const utils::entity_handle* handles, int unit_count,
+        const circle_scoring::point* centers, int center_count, float radius, float kill_weight, farm_policy policy,
+        float impact_window)
+    {
+        if (!recording || unit_count == 0)
+            return;
+
+        float now = gametime->get_time();
+        if (now - last_farm_time < RECORD_INTERVAL)
+            return;
+        last_farm_time = now;
+
+        farms.emplace_back();
+        auto& farm = farms.back();
+        farm.data = make_sample(sample_kind::farm, slot);
+        farm.impact_window = impact_window;
+        farm.label_at = now + FARM_CAST_WINDOW + impact_window;
+
+        auto& data = farm.data.farm;
+        data.radius = radius;
+        data.kill_weight = kill_weight;
+        data.policy = policy;
+        data.minion_count = static_cast<std::uint8_t>(std::min(unit_count, MAX_MINIONS));
+        data.center_count = static_cast<std::uint8_t>(std::min(center_count, MAX_CENTERS));
+        for (int i = 0; i < data.minion_count; ++i)
+        {
+            data.minions[i].x = units[i].x;
+            data.minions[i].y = units[i].y;
+            data.minions[i].killable = units[i].killable ? 1 : 0;
+            farm.handles[i] = handles[i];
+            farm.died_at[i] = -1.0f;
+            farm.lost[i] = false;
+        }
+        for (int i = 0; i < data.center_count; ++i)
+            data.centers[i] = { centers[i].x, centers[i].y };
+    }
+
+    void on_cast(script_spell* spell, const vector& position, game_object_script unit)
+    {
+        if (!recording)
+            return;
+
+        float now = gametime->get_time();
+        bool skillshot = unit && unit->is_ai_hero() && unit->is_enemy() && spell->radius > 0.0f;
+        vector landing = position;
+        prediction_output prediction;
+        if (skillshot)
+        {
+            prediction = spell->get_prediction(unit);
+            landing = prediction.get_cast_position();
+        }
+        else if (unit)
+            landing = unit->get_position();
+        else if (!landing.is_valid())
+            landing = myhero->get_position();
+
+        casts[next_cast] = { spell->slot, landing.x, landing.y, now };
+        next_cast = (next_cast + 1) % RECENT_CASTS;
+
+        if (spell->slot == spellslot::r && unit && unit->is_ally())
+        {
+            auto id = unit->get_id();
+            for (auto& ult : ults)
+            {
+                if (ult.ally_id == id)
+                    ult.ulted = true;
+            }
+        }
+
+        if (!skillshot)
+            return;
+
+        float range = std::max(spell->range(), 1.0f);
+        float distance = myhero->get_distance(unit);
+        float travel = spell->delay + (spell->speed > 0.0f ? distance / spell->speed : 0.0f);
+
+        skillshots.emplace_back();
+        auto& shot = skillshots.back();
+        shot.data = make_sample(sample_kind::skillshot, spell->slot);
+        shot.data.skillshot.hitchance = static_cast<std::uint8_t>(prediction.hitchance);
+        shot.data.skillshot.outcome = cast_outcome::unknown;
+        shot.data.skillshot.range_percent = distance / range * 100.0f;
+        shot.target = utils::make_handle(unit);
+        shot.target_id = unit->get_id();
+        shot.label_at = now + travel + SKILLSHOT_LABEL_GRACE;
+    }
+
+    void record_ally(game_object_script ally, float hp_percent, float other_score)
+    {
+        if (!recording || !ally || (hp_percent > ULT_RECORD_HP && other_score < ULT_RECORD_SCORE))
+            return;
+
+        float now = gametime->get_time();
+        auto id = ally->get_id();
+        auto episode = std::find_if(episodes.begin(), episodes.end(), [id](const ally_episode& e) { return e.ally_id == id; });
+        if (episode == episodes.end())
+        {
+            episodes.push_back({ id, 0, -1.0f });
+            episode = episodes.end() - 1;
+        }
+        if (episode->last_time >= 0.0f && now - episode->last_time < RECORD_INTERVAL)
+            return;
+        if (episode->last_time < 0.0f || now - episode->last_time > EPISODE_GAP)
+            episode->episode = ++next_episode;
+        episode->last_time = now;
+
+        ults.emplace_back();
+        auto& ult = ults.back();
+        ult.data = make_sample(sample_kind::ult, spellslot::r);
+        ult.data.ult.episode = episode->episode;
+        ult.data.ult.hp_percent = hp_percent;
+        ult.data.ult.other_score = other_score;
+        ult.ally = utils::make_handle(ally);
+        ult.ally_id = id;
+        ult.label_at = now + ULT_LABEL_WINDOW;
+    }
+
+    void begin_allin(game_object_script target, float earliest_swap)
+    {
+        if (!recording || !target)
+            return;
+        if (allin.active)
+            finish_allin();
+
+        allin.active = true;
+        allin.data = make_sample(sample_kind::swap_back, spellslot::w);
+        allin.data.swap.earliest_swap = earliest_swap;
+        allin.data.swap.target_died_at = -1.0f;
+        allin.target = utils::make_handle(target);
+        allin.start = gametime->get_time();
+        allin.swapped_at = -1.0f;
+        allin.target_lost = false;
+        update_allin(allin.start);
+    }
+
+    void mark_swap()
+    {
+        if (!recording || !allin.active || allin.swapped_at >= 0.0f)
+            return;
+        allin.swapped_at = gametime->get_time();
+    }
+}
@@ -0,0 +1,39 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+#include "tuner_format.h"
+#include "circle_scoring.h"
+#include "utils.h"
+
+#pragma once
+namespace tuner
+{
+    constexpr float RECORD_INTERVAL = 0.25f;
+    // Our casts of the sampled slot this long after a farm tick count as its decision
+    constexpr float FARM_CAST_WINDOW = 0.5f;
+    constexpr float SKILLSHOT_LABEL_GRACE = 0.25f;
+    constexpr float ULT_LABEL_WINDOW = 3.0f;
+    constexpr float ULT_RECORD_HP = 70.0f; // top of the r_min_hp slider
+    constexpr float EPISODE_GAP = 1.0f;
+
+    // Recorder lifetime. Labelled samples are appended to luvvy_tuner.<champion>.<start>.bin in the
+    // process working directory; tools/tuner.cpp sweeps the menu values offline over those files.
+    //
+    void load();
+    void unload();
+    void set_recording(bool recording);
+    bool is_recording();
+
+    // Decision hooks, all no-ops unless recording
+    //
+    // Farm tick: minions with their kill forecast and the solver's candidate centers. Deaths inside our
+    // cast of `slot` within impact_window of the cast are labelled as our kills.
+    void record_farm(spellslot slot, const circle_scoring::point* units, const utils::entity_handle* handles, int unit_count,
+        const circle_scoring::point* centers, int center_count, float radius, float kill_weight, tuner_format::farm_policy policy,
+        float impact_window);
+    // Every cast the SDK accepted from utils::cast. Skillshots at enemy heroes become samples, a hit is
+    // the target gaining any buff from us before the spell could have landed plus a small grace.
+    void on_cast(script_spell* spell, const vector& position, game_object_script unit);
+    void record_ally(game_object_script ally, float hp_percent, float other_score);
+    // All-in start and the W2/R2 swap back; earliest_swap is relative to now
+    void begin_allin(game_object_script target, float earliest_swap);
+    void mark_swap();
+};
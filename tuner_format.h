@@ -0,0 +1,143 @@
+#pragma once
+#include <cstdint>
+
+// On-disk layout of the tuner corpus. Shared with tools/tuner.cpp, so this header must stay free of
+// the SDK. A file is one file_header followed by fixed-size samples; every sample is one decision the
+// plugin saw, written once its outcome has been labelled.
+namespace tuner_format
+{
+    constexpr std::uint32_t MAGIC = 0x4E54564C; // "LVTN"
+    constexpr std::uint32_t VERSION = 1;
+    constexpr int NAME_SIZE = 32;
+    constexpr int MAX_MINIONS = 64;
+    constexpr int MAX_CENTERS = 64;
+    constexpr int SWAP_TRACE = 20;
+    constexpr float SWAP_TRACE_STEP = 0.1f;
+
+    enum class sample_kind : std::uint8_t
+    {
+        farm = 1,
+        skillshot,
+        ult,
+        swap_back
+    };
+
+    // How a farm decision picks its center out of the scored candidates
+    enum class farm_policy : std::uint8_t
+    {
+        best_score = 0,
+        first_fit  // first candidate (closest) that reaches the minimum count
+    };
+
+    enum class minion_outcome : std::uint8_t
+    {
+        unknown = 0,  // left vision or vanished before it was seen dead
+        alive,
+        killed_by_us, // died inside the area of our cast of the sampled slot, within its impact window
+        died_other
+    };
+
+    enum class cast_outcome : std::uint8_t
+    {
+        unknown = 0,
+        hit,
+        miss
+    };
+
+    enum class ally_outcome : std::uint8_t
+    {
+        unknown = 0, // our R reached the ally during the window, so the counterfactual is lost
+        survived,
+        died
+    };
+
+    struct file_header
+    {
+        std::uint32_t magic = MAGIC;
+        std::uint32_t version = VERSION;
+        std::uint32_t header_size = sizeof(file_header);
+        std::uint32_t record_size = 0;
+        // Wall clock at recording start (unix seconds)
+        std::int64_t session_start = 0;
+        char champion[NAME_SIZE] = {};
+    };
+
+    struct farm_minion
+    {
+        float x;
+        float y;
+        std::uint8_t killable;
+        minion_outcome outcome;
+        std::uint8_t reserved[2];
+    };
+
+    struct farm_center
+    {
+        float x;
+        float y;
+    };
+
+    // One farm tick: the units and candidate centers the solver saw, in the order it saw them
+    struct farm_sample
+    {
+        float radius;
+        float kill_weight;
+        farm_policy policy;
+        std::uint8_t minion_count;
+        std::uint8_t center_count;
+        std::uint8_t reserved;
+        farm_minion minions[MAX_MINIONS];
+        farm_center centers[MAX_CENTERS];
+    };
+
+    // One cast at an enemy hero; hitchance is the prediction's hit_chance value at cast time
+    struct skillshot_sample
+    {
+        std::uint8_t hitchance;
+        cast_outcome outcome;
+        std::uint8_t reserved[2];
+        float range_percent;
+    };
+
+    // One look at an ally in danger; looks at the same ally less than a second apart share the episode.
+    // other_score is the danger score without the HP term, the HP term is min_hp / hp_percent.
+    struct ult_sample
+    {
+        std::uint32_t episode;
+        float hp_percent;
+        float other_score;
+        ally_outcome outcome;
+        std::uint8_t reserved[3];
+    };
+
+    // One all-in: own HP every SWAP_TRACE_STEP from the start, up to the recorded swap back.
+    // target_died_at is relative to the start, negative when the target was not seen dying.
+    struct swap_sample
+    {
+        float earliest_swap;
+        float target_died_at;
+        std::uint8_t target_known;
+        std::uint8_t trace_count;
+        std::uint8_t reserved[2];
+        float hp_percent[SWAP_TRACE];
+    };
+
+    struct sample
+    {
+        sample_kind kind;
+        // spellslot of the decision, see the SDK's enum
+        std::int8_t slot;
+        std::uint8_t reserved[2];
+        float game_time;
+        union
+        {
+            farm_sample farm;
+            skillshot_sample skillshot;
+            ult_sample ult;
+            swap_sample swap;
+        };
+    };
+
+    static_assert(sizeof(file_header) % 8 == 0, "samples must stay aligned when mapped");
+    static_assert(sizeof(sample) % 4 == 0, "samples must stay aligned when mapped");
+}
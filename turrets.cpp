@@ -0,0 +1,120 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+#include "turrets.h"
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace turrets
+{
+    struct turret_entry
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+        std::uint32_t network_id = 0;
+        game_object_script object = nullptr;
+    };
+
+    // Turrets never move, so the index is built once and sorted by x. Entries keep the object rather
+    // than a handle: the set is fixed, dead ones are skipped and on_delete_object removes them.
+    // Range queries only walk the slice of turrets whose x is within range.
+    static std::vector<turret_entry> enemy_turrets;
+
+    static bool entry_x_less(const turret_entry& entry, float x)
+    {
+        return entry.x < x;
+    }
+
+    // A destroyed turret can linger as a dead object before on_delete_object drops its entry
+    static bool is_alive(const turret_entry& entry)
+    {
+        return entry.object && entry.object->is_valid() && !entry.object->is_dead();
+    }
+
+    void on_delete_object(game_object_script sender)
+    {
+        if (!sender || !sender->is_ai_turret())
+            return;
+
+        auto id = sender->get_network_id();
+        enemy_turrets.erase(std::remove_if(enemy_turrets.begin(), enemy_turrets.end(), [id](const turret_entry& entry) {
+            return entry.network_id == id;
+        }), enemy_turrets.end());
+    }
+
+    void load()
+    {
+        enemy_turrets.clear();
+        for (auto& turret : entitylist->get_enemy_turrets())
+        {
+            if (!turret || !turret->is_valid() || turret->is_dead())
+                continue;
+
+            auto pos = turret->get_position();
+            enemy_turrets.push_back({ pos.x, pos.y, turret->get_network_id(), turret });
+        }
+        std::sort(enemy_turrets.begin(), enemy_turrets.end(), [](const turret_entry& a, const turret_entry& b) {
+            return a.x < b.x;
+        });
+
+        event_handler<events::on_delete_object>::add_callback(on_delete_object);
+    }
+
+    void unload()
+    {
+        event_handler<events::on_delete_object>::remove_handler(on_delete_object);
+        enemy_turrets.clear();
+    }
+
+    game_object_script get_nearest_enemy(const vector& pos, float* out_distance)
+    {
+        game_object_script best = nullptr;
+        float best_dist_sq = std::numeric_limits<float>::max();
+
+        // Walk outwards from pos.x in both directions, stopping once the x gap alone exceeds the best distance
+        auto split = std::lower_bound(enemy_turrets.begin(), enemy_turrets.end(), pos.x, entry_x_less);
+        for (auto it = split; it != enemy_turrets.end(); ++it)
+        {
+            float dx = it->x - pos.x;
+            if (dx * dx >= best_dist_sq) break;
+            float dy = it->y - pos.y;
+            float dist_sq = dx * dx + dy * dy;
+            if (dist_sq < best_dist_sq && is_alive(*it))
+            {
+                best_dist_sq = dist_sq;
+                best = it->object;
+            }
+        }
+        for (auto it = split; it != enemy_turrets.begin();)
+        {
+            --it;
+            float dx = pos.x - it->x;
+            if (dx * dx >= best_dist_sq) break;
+            float dy = it->y - pos.y;
+            float dist_sq = dx * dx + dy * dy;
+            if (dist_sq < best_dist_sq && is_alive(*it))
+            {
+                best_dist_sq = dist_sq;
+                best = it->object;
+            }
+        }
+
+        if (out_distance)
+            *out_distance = best ? std::sqrt(best_dist_sq) : std::numeric_limits<float>::max();
+        return best;
+    }
+
+    bool is_in_enemy_range(const vector& pos, float range)
+    {
+        float range_sq = range * range;
+        auto it = std::lower_bound(enemy_turrets.begin(), enemy_turrets.end(), pos.x - range, entry_x_less);
+        for (; it != enemy_turrets.end() && it->x <= pos.x + range; ++it)
+        {
+            float dx = it->x - pos.x;
+            float dy = it->y - pos.y;
+            if (dx * dx + dy * dy < range_sq && is_alive(*it))
+                return true;
+        }
+        return false;
+    }
+}
@@ -0,0 +1,17 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+
+#pragma once
+namespace turrets
+{
+    constexpr float TURRET_RANGE = 775.0f;
+
+    // Index lifetime
+    //
+    void load();
+    void unload();
+
+    // Queries
+    //
+    game_object_script get_nearest_enemy(const vector& pos, float* out_distance = nullptr);
+    bool is_in_enemy_range(const vector& pos, float range = TURRET_RANGE);
+};
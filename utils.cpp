@@ -1,18 +1,392 @@
 #include "../plugin_sdk/plugin_sdk.hpp"
 #include "utils.h"
+#include "logger.h"
+#include "alloc_counter.h"
+#include "worker.h"
+#include "parallel.h"
+#include "tuner.h"
+#include "watchdog.h"
+#include "cast_tracker.h"
+#include "telemetry.h"
 #include <map>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <cstdio>
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <xmmintrin.h>
 
 namespace utils
 {
     // Declaration of menu objects
     TreeTab* main_tab = nullptr;
 
-    // Delays map
-    std::map<spellslot, float> delays;
-
     namespace developer
     {
         TreeEntry* debug_mode = nullptr;
+        TreeEntry* alloc_label = nullptr;
+        TreeEntry* alloc_assert = nullptr;
+        TreeEntry* worker_mode = nullptr;
+        TreeEntry* run_benchmark = nullptr;
+        TreeEntry* run_collision_benchmark = nullptr;
+        TreeEntry* record_ticks = nullptr;
+        TreeEntry* tick_budget = nullptr;
+        TreeEntry* quality_label = nullptr;
+        TreeEntry* transition_label = nullptr;
+        TreeEntry* latency_label = nullptr;
+        TreeEntry* record_telemetry = nullptr;
+    }
+
+    std::uint64_t tick_id = 0;
+
+    // Allocation accounting, updated at every tick boundary
+    namespace alloc_stats
+    {
+        constexpr int WARMUP_TICKS = 300;
+        constexpr float LABEL_INTERVAL = 1.0f;
+
+        int ticks = 0;
+        std::uint64_t worst_allocations = 0;
+        float last_label_time = 0.0f;
+        float last_assert_time = -10.0f;
+    }
+
+    // Quality watchdog display, the level itself lives in watchdog
+    namespace quality_stats
+    {
+        constexpr float LABEL_INTERVAL = 1.0f;
+
+        float last_label_time = 0.0f;
+    }
+
+    // Cast round trip display, the histograms live in cast_tracker
+    namespace latency_stats
+    {
+        constexpr float LABEL_INTERVAL = 1.0f;
+
+        float last_label_time = 0.0f;
+    }
+
+    // Per-tick SoA snapshot of enemy minions sorted by x, padded to a multiple of 4 for SSE
+    namespace minion_index
+    {
+        constexpr float MAX_MINION_RADIUS = 100.0f;
+
+        float snapshot_time = -1.0f;
+        std::vector<float> xs;
+        std::vector<float> ys;
+        std::vector<float> radii;
+        std::vector<game_object_script> objects;
+        std::uint32_t last_blocker_id = 0;
+    }
+
+    // Frame arena storage; overflow falls back to the heap and is released on reset
+    namespace frame_arena
+    {
+        constexpr std::size_t CAPACITY = 256 * 1024;
+
+        std::unique_ptr<std::uint8_t[]> block;
+        std::size_t offset = 0;
+        std::vector<std::unique_ptr<std::uint8_t[]>> overflow;
+    }
+
+    // Handle slots plus a linear-probing network id -> slot index, sized for every unit alive at once
+    namespace handle_table
+    {
+        constexpr int CAPACITY = 1024;
+        constexpr int INDEX_SIZE = CAPACITY * 2;
+        constexpr std::uint16_t EMPTY = 0xFFFF;
+
+        struct slot
+        {
+            game_object_script object = nullptr;
+            std::uint32_t network_id = 0;
+            std::uint16_t generation = 0;
+        };
+
+        slot slots[CAPACITY];
+        std::uint16_t index[INDEX_SIZE];
+        std::uint16_t free_list[CAPACITY];
+        int free_count = 0;
+
+        int home(std::uint32_t network_id)
+        {
+            return static_cast<int>((network_id * 2654435761u) >> 21) & (INDEX_SIZE - 1);
+        }
+
+        int find(std::uint32_t network_id)
+        {
+            for (int i = home(network_id); index[i] != EMPTY; i = (i + 1) & (INDEX_SIZE - 1))
+            {
+                if (slots[index[i]].network_id == network_id)
+                    return i;
+            }
+            return -1;
+        }
+
+        // Backward shift keeps probe chains intact without tombstones
+        void erase(int position)
+        {
+            int hole = position;
+            for (int i = (position + 1) & (INDEX_SIZE - 1); index[i] != EMPTY; i = (i + 1) & (INDEX_SIZE - 1))
+            {
+                int want = home(slots[index[i]].network_id);
+                bool movable = hole <= i ? (want <= hole || want > i) : (want <= hole && want > i);
+                if (movable)
+                {
+                    index[hole] = index[i];
+                    hole = i;
+                }
+            }
+            index[hole] = EMPTY;
+        }
+
+        void reset()
+        {
+            for (int i = 0; i < CAPACITY; ++i)
+            {
+                slots[i].object = nullptr;
+                slots[i].network_id = 0;
+                ++slots[i].generation;
+                free_list[i] = static_cast<std::uint16_t>(CAPACITY - 1 - i);
+            }
+            free_count = CAPACITY;
+            std::fill(index, index + INDEX_SIZE, EMPTY);
+        }
+    }
+
+    void on_handle_object_delete(game_object_script sender)
+    {
+        if (!sender)
+            return;
+
+        int position = handle_table::find(sender->get_network_id());
+        if (position < 0)
+            return;
+
+        auto slot_index = handle_table::index[position];
+        auto& slot = handle_table::slots[slot_index];
+        slot.object = nullptr;
+        slot.network_id = 0;
+        ++slot.generation;
+        handle_table::erase(position);
+        handle_table::free_list[handle_table::free_count++] = slot_index;
+    }
+
+    entity_handle lookup_handle(const game_object_script& unit)
+    {
+        entity_handle handle;
+        if (!unit)
+            return handle;
+
+        int position = handle_table::find(unit->get_network_id());
+        if (position >= 0)
+        {
+            handle.index = handle_table::index[position];
+            handle.generation = handle_table::slots[handle.index].generation;
+        }
+        return handle;
+    }
+
+    entity_handle make_handle(const game_object_script& unit)
+    {
+        entity_handle handle;
+        if (!unit)
+            return handle;
+
+        handle = lookup_handle(unit);
+        if (handle.is_set() || handle_table::free_count == 0)
+            return handle;
+
+        auto network_id = unit->get_network_id();
+        auto slot_index = handle_table::free_list[--handle_table::free_count];
+        auto& slot = handle_table::slots[slot_index];
+        slot.object = unit;
+        slot.network_id = network_id;
+
+        int i = handle_table::home(network_id);
+        while (handle_table::index[i] != handle_table::EMPTY)
+            i = (i + 1) & (handle_table::INDEX_SIZE - 1);
+        handle_table::index[i] = slot_index;
+
+        handle.index = slot_index;
+        handle.generation = slot.generation;
+        return handle;
+    }
+
+    game_object_script resolve(entity_handle handle)
+    {
+        if (handle.index >= handle_table::CAPACITY)
+            return nullptr;
+        auto& slot = handle_table::slots[handle.index];
+        return slot.generation == handle.generation ? slot.object : nullptr;
+    }
+
+    void handles_load()
+    {
+        handle_table::reset();
+        event_handler<events::on_delete_object>::add_callback(on_handle_object_delete);
+    }
+
+    void handles_unload()
+    {
+        event_handler<events::on_delete_object>::remove_handler(on_handle_object_delete);
+        handle_table::reset();
+    }
+
+    void frame_arena_reset()
+    {
+        frame_arena::offset = 0;
+        frame_arena::overflow.clear();
+    }
+
+    void update_alloc_stats()
+    {
+        if (!alloc_counter::is_compiled_in())
+            return;
+
+        auto tick = alloc_counter::end_tick();
+        bool steady = ++alloc_stats::ticks > alloc_stats::WARMUP_TICKS;
+        if (steady)
+            alloc_stats::worst_allocations = std::max(alloc_stats::worst_allocations, tick.allocations);
+
+        if (tick.allocations > 0)
+        {
+            LUVVY_LOG(logger::level::trace, logger::make_allocations("tick", tick.allocations, tick.bytes));
+
+            int probe_count = 0;
+            auto probes = alloc_counter::get_probes(&probe_count);
+            for (int i = 0; i < probe_count; ++i)
+            {
+                if (probes[i].last_tick.allocations > 0)
+                    LUVVY_LOG(logger::level::trace, logger::make_allocations(probes[i].name, probes[i].last_tick.allocations, probes[i].last_tick.bytes));
+            }
+        }
+
+        float now = gametime->get_time();
+        if (steady && tick.allocations > 0 && developer::alloc_assert && developer::alloc_assert->get_bool()
+            && now - alloc_stats::last_assert_time > 1.0f)
+        {
+            alloc_stats::last_assert_time = now;
+            LUVVY_LOG(logger::level::error, logger::make_allocations("steady-state tick", tick.allocations, tick.bytes));
+            console->print("[luvvy] zero-allocation assertion failed: %d allocations (%d bytes) in one tick",
+                static_cast<int>(tick.allocations), static_cast<int>(tick.bytes));
+        }
+
+        // The label update allocates itself, so it is throttled and happens after the tick was measured
+        if (developer::alloc_label && now - alloc_stats::last_label_time > alloc_stats::LABEL_INTERVAL)
+        {
+            alloc_stats::last_label_time = now;
+            char text[128];
+            std::snprintf(text, sizeof(text), "Allocs/tick: %llu (%llu B), worst steady: %llu",
+                static_cast<unsigned long long>(tick.allocations), static_cast<unsigned long long>(tick.bytes),
+                static_cast<unsigned long long>(alloc_stats::worst_allocations));
+            developer::alloc_label->set_display_name(text);
+            alloc_counter::discard();
+        }
+    }
+
+    void update_quality_level()
+    {
+        watchdog::transition change;
+        bool changed = watchdog::end_tick(&change);
+        float now = gametime->get_time();
+
+        if (changed)
+        {
+            LUVVY_LOG(logger::level::warn, logger::make_message(watchdog::get_level_name(change.to), static_cast<std::int32_t>(change.average_ms * 1000.0f)));
+            if (developer::transition_label)
+            {
+                char text[160];
+                std::snprintf(text, sizeof(text), "Last change: %s -> %s at %.0fs (%.2f ms avg, worst %s)",
+                    watchdog::get_level_name(change.from), watchdog::get_level_name(change.to), now,
+                    change.average_ms, change.worst_module ? change.worst_module : "-");
+                developer::transition_label->set_display_name(text);
+            }
+        }
+
+        if (developer::quality_label && (changed || now - quality_stats::last_label_time > quality_stats::LABEL_INTERVAL))
+        {
+            quality_stats::last_label_time = now;
+            char text[128];
+            std::snprintf(text, sizeof(text), "Quality: %s (%.2f / %.1f ms)",
+                watchdog::get_level_name(watchdog::get_level()), watchdog::get_average_ms(), watchdog::get_budget_ms());
+            developer::quality_label->set_display_name(text);
+        }
+    }
+
+    void update_latency_label()
+    {
+        float now = gametime->get_time();
+        if (!developer::latency_label || now - latency_stats::last_label_time < latency_stats::LABEL_INTERVAL)
+            return;
+        latency_stats::last_label_time = now;
+
+        static const char* names[] = { "Q", "W", "E", "R" };
+        char text[192];
+        int length = std::snprintf(text, sizeof(text), "Cast ms p50/p95:");
+        int unconfirmed = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            auto stats = cast_tracker::get_stats(static_cast<spellslot>(i));
+            unconfirmed += stats.unconfirmed;
+            if (stats.samples == 0)
+                length += std::snprintf(text + length, sizeof(text) - length, " %s -", names[i]);
+            else
+                length += std::snprintf(text + length, sizeof(text) - length, " %s %.0f/%.0f", names[i], stats.p50 * 1000.0f, stats.p95 * 1000.0f);
+        }
+        std::snprintf(text + length, sizeof(text) - length, ", unconfirmed %d", unconfirmed);
+        developer::latency_label->set_display_name(text);
+    }
+
+    std::uint64_t get_tick()
+    {
+        return tick_id;
+    }
+
+    void on_frame_start()
+    {
+        ++tick_id;
+        frame_arena_reset();
+        update_quality_level();
+        update_latency_label();
+        update_alloc_stats();
+        telemetry::record_tick();
+    }
+
+    void frame_arena_load()
+    {
+        frame_arena::block.reset(new std::uint8_t[frame_arena::CAPACITY]);
+        frame_arena::overflow.reserve(16);
+        frame_arena_reset();
+        alloc_counter::load();
+
+        // Registered before any module so the reset runs first every tick
+        event_handler<events::on_update>::add_callback(on_frame_start);
+    }
+
+    void frame_arena_unload()
+    {
+        event_handler<events::on_update>::remove_handler(on_frame_start);
+        frame_arena_reset();
+        frame_arena::block.reset();
+    }
+
+    void* frame_arena_allocate(std::size_t bytes, std::size_t alignment)
+    {
+        std::size_t aligned = (frame_arena::offset + alignment - 1) & ~(alignment - 1);
+        if (frame_arena::block && aligned + bytes <= frame_arena::CAPACITY)
+        {
+            frame_arena::offset = aligned + bytes;
+            return frame_arena::block.get() + aligned;
+        }
+
+        frame_arena::overflow.emplace_back(new std::uint8_t[bytes + alignment]);
+        auto raw = reinterpret_cast<std::uintptr_t>(frame_arena::overflow.back().get());
+        return reinterpret_cast<void*>((raw + alignment - 1) & ~(std::uintptr_t(alignment) - 1));
     }
 
     // Minion count utility (the new function)
@@ -27,19 +401,87 @@ namespace utils
         return count;
     }
 
-    void on_load()
+    void on_debug_mode_change(TreeEntry* entry)
+    {
+        logger::set_active(entry->get_bool());
+    }
+
+    void on_worker_mode_change(TreeEntry* entry)
+    {
+        worker::set_enabled(entry->get_bool());
+    }
+
+    void on_run_benchmark_change(TreeEntry* entry)
+    {
+        if (!entry->get_bool())
+            return;
+        entry->set_bool(false);
+        parallel::run_benchmark();
+    }
+
+    void on_run_collision_benchmark_change(TreeEntry* entry)
+    {
+        if (!entry->get_bool())
+            return;
+        entry->set_bool(false);
+        run_collision_benchmark();
+    }
+
+    void on_tick_budget_change(TreeEntry* entry)
+    {
+        watchdog::set_budget_ms(entry->get_int() / 10.0f);
+    }
+
+    void on_record_ticks_change(TreeEntry* entry)
     {
-        std::string data = myhero->get_model();
-        std::transform(data.begin(), data.end(), data.begin(),
-            [](unsigned char c) { return std::tolower(c); });
+        tuner::set_recording(entry->get_bool());
+    }
 
-        main_tab = menu->get_tab(data);
+    void on_record_telemetry_change(TreeEntry* entry)
+    {
+        telemetry::set_active(entry->get_bool());
+    }
+
+    void on_load(TreeTab* champion_tab)
+    {
+        main_tab = champion_tab;
         if (main_tab != nullptr)
         {
             auto developer = main_tab->add_tab(myhero->get_model() + ".developer", "Developer Settings");
             {
                 developer->add_separator(myhero->get_model() + ".aio", "Luvvy : meowlista build 1");
-                developer::debug_mode = developer->add_checkbox(myhero->get_model() + ".developer.debug_mode", "Debug Mode", false);
+                developer::debug_mode = developer->add_checkbox(myhero->get_model() + ".developer.debug_mode", "Debug Mode (log to file)", false);
+                developer::debug_mode->add_property_change_callback(on_debug_mode_change);
+                logger::set_active(developer::debug_mode->get_bool());
+
+                developer::tick_budget = developer->add_slider(myhero->get_model() + ".developer.tick_budget", "Tick budget (0.1 ms)", static_cast<int>(watchdog::DEFAULT_BUDGET_MS * 10.0f), 5, 100);
+                developer::tick_budget->add_property_change_callback(on_tick_budget_change);
+                watchdog::set_budget_ms(developer::tick_budget->get_int() / 10.0f);
+                developer::quality_label = developer->add_separator(myhero->get_model() + ".developer.quality", "Quality: full");
+                developer::transition_label = developer->add_separator(myhero->get_model() + ".developer.quality_change", "Last change: -");
+                developer::latency_label = developer->add_separator(myhero->get_model() + ".developer.latency", "Cast ms p50/p95: -");
+                developer::record_telemetry = developer->add_checkbox(myhero->get_model() + ".developer.record_telemetry", "Record tick telemetry to file", false);
+                developer::record_telemetry->add_property_change_callback(on_record_telemetry_change);
+                telemetry::set_active(developer::record_telemetry->get_bool());
+
+                developer::worker_mode = developer->add_checkbox(myhero->get_model() + ".developer.worker_mode", "Run farm solvers on worker thread", false);
+                developer::worker_mode->add_property_change_callback(on_worker_mode_change);
+                worker::set_enabled(developer::worker_mode->get_bool());
+                developer::run_benchmark = developer->add_checkbox(myhero->get_model() + ".developer.run_benchmark", "Run solver scaling benchmark", false);
+                developer::run_benchmark->set_bool(false);
+                developer::run_benchmark->add_property_change_callback(on_run_benchmark_change);
+                developer::run_collision_benchmark = developer->add_checkbox(myhero->get_model() + ".developer.run_collision_benchmark", "Run collision precheck benchmark", false);
+                developer::run_collision_benchmark->set_bool(false);
+                developer::run_collision_benchmark->add_property_change_callback(on_run_collision_benchmark_change);
+                developer::record_ticks = developer->add_checkbox(myhero->get_model() + ".developer.record_ticks", "Record decisions for tuner", false);
+                developer::record_ticks->add_property_change_callback(on_record_ticks_change);
+                tuner::set_recording(developer::record_ticks->get_bool());
+
+                if (alloc_counter::is_compiled_in())
+                {
+                    developer::alloc_label = developer->add_separator(myhero->get_model() + ".developer.allocs", "Allocs/tick: -");
+                    developer::alloc_assert = developer->add_checkbox(myhero->get_model() + ".developer.alloc_assert", "Assert zero allocations per tick", false);
+                }
             }
         }
 
@@ -47,6 +489,11 @@ namespace utils
         myhero->print_chat(1, msg.c_str());
     }
 
+    void on_load()
+    {
+        on_load(nullptr);
+    }
+
     bool has_unkillable_buff(game_object_script target)
     {
         return target->is_zombie() || target->has_buff({ buff_hash("UndyingRage"), buff_hash("ChronoShift"), buff_hash("KayleR"), buff_hash("KindredRNoDeathBuff") });
@@ -74,55 +521,54 @@ namespace utils
         });
     }
 
-    bool is_empowered()
-    {
-        return myhero->get_mana() >= 4.0f;
-    }
-
     bool fast_cast(script_spell* spell)
     {
-        if (main_tab != nullptr && developer::debug_mode->get_bool())
-        {
-            myhero->print_chat(1, "[luvvyAIO Debug] Fast Cast (spell) %s ready: %s state: %d empowered: %s", spell->name().c_str(), spell->is_ready() ? "Yes" : "No", spell->toogle_state(), is_empowered() ? "Yes" : "No");
-        }
+        if (!cast_tracker::can_cast(spell->slot))
+            return false;
+
+        LUVVY_LOG(logger::level::debug, logger::make_cast(logger::event::cast_self, spell->slot));
         myhero->cast_spell(spell->slot, true, spell->is_charged_spell);
+        cast_tracker::issued(spell->slot);
         return true;
     }
 
     bool cast(spellslot slot, bool is_charged_spell)
     {
-        if (gametime->get_time() < delays[slot] + sciprt_spell_wait)
+        if (!cast_tracker::can_cast(slot))
             return false;
 
         myhero->cast_spell(slot, true, is_charged_spell);
-        delays[slot] = gametime->get_time();
+        cast_tracker::issued(slot);
         return true;
     }
 
     bool cast(spellslot slot, game_object_script unit, bool is_charged_spell)
     {
-        if (gametime->get_time() < delays[slot] + sciprt_spell_wait)
+        if (!cast_tracker::can_cast(slot))
             return false;
 
         myhero->cast_spell(slot, unit, true, is_charged_spell);
-        delays[slot] = gametime->get_time();
+        cast_tracker::issued(slot);
         return true;
     }
 
     bool fast_cast(script_spell* spell, vector position)
     {
-        if (main_tab != nullptr && developer::debug_mode->get_bool())
-        {
-            myhero->print_chat(1, "[LuvvyAIO Debug] Fast Cast (spell, position) %s ready: %s state: %d empowered: %s", spell->name().c_str(), spell->is_ready() ? "Yes" : "No", spell->toogle_state(), is_empowered() ? "Yes" : "No");
-        }
+        bool charging = spell->is_charged_spell && spell->is_charging();
+        if ((!spell->is_charged_spell || charging) && !cast_tracker::can_cast(spell->slot))
+            return false;
+
+        LUVVY_LOG(logger::level::debug, logger::make_cast(logger::event::cast_position, spell->slot, 0, position));
         if (!spell->is_charged_spell)
         {
             myhero->cast_spell(spell->slot, position);
+            cast_tracker::issued(spell->slot);
             return true;
         }
-        if (spell->is_charging() && gametime->get_time() - spell->charging_started_time > 0.f)
+        if (charging && gametime->get_time() - spell->charging_started_time > 0.f)
         {
             myhero->update_charged_spell(spell->slot, position, true);
+            cast_tracker::issued(spell->slot);
             return true;
         }
         return spell->start_charging();
@@ -130,21 +576,21 @@ namespace utils
 
     bool cast(spellslot slot, vector position, bool is_charged_spell)
     {
-        if (gametime->get_time() < delays[slot] + sciprt_spell_wait)
+        if (!cast_tracker::can_cast(slot))
             return false;
 
         myhero->cast_spell(slot, position, true, is_charged_spell);
-
-        delays[slot] = gametime->get_time();
+        cast_tracker::issued(slot);
         return true;
     }
 
     bool fast_cast(script_spell* spell, game_object_script unit, hit_chance minimum, bool aoe, int min_targets)
     {
-        if (main_tab != nullptr && developer::debug_mode->get_bool())
-        {
-            myhero->print_chat(1, "[LuvvyAIO Debug] Fast Cast (spell, unit) %s unit: %s ready: %s state: %d empowered: %s", spell->name().c_str(), unit->get_name_cstr(), spell->is_ready() ? "Yes" : "No", spell->toogle_state(), is_empowered() ? "Yes" : "No");
-        }
+        // Checked before the prediction so throttled casts cost nothing
+        if (!cast_tracker::can_cast(spell->slot))
+            return false;
+
+        LUVVY_LOG(logger::level::debug, logger::make_cast(logger::event::cast_unit, spell->slot, unit->get_network_id(), unit->get_position()));
 
         vector cast_position;
 
@@ -175,12 +621,14 @@ namespace utils
             if (!spell->is_charged_spell)
             {
                 myhero->cast_spell(spell->slot, cast_position);
+                cast_tracker::issued(spell->slot);
                 return true;
             }
 
             if (spell->is_charging() && gametime->get_time() - spell->charging_started_time > 0.f)
             {
                 myhero->update_charged_spell(spell->slot, cast_position, true);
+                cast_tracker::issued(spell->slot);
                 return true;
             }
         }
@@ -189,23 +637,25 @@ namespace utils
 
     bool fast_cast(script_spell* spell, int minMinions, bool is_jugnle_mobs)
     {
+        if (!cast_tracker::can_cast(spell->slot))
+            return false;
+
         auto best_pos = spell->get_cast_on_best_farm_position(minMinions, is_jugnle_mobs);
 
         if (best_pos.is_valid())
         {
             if (!spell->is_charged_spell)
             {
-                if (developer::debug_mode->get_bool())
-                {
-                    myhero->print_chat(1, "[LuvvyAIO Debug] Fast Cast (spell, farm) %s ready: %s state: %d", spell->name().c_str(), spell->is_ready() ? "Yes" : "No", spell->toogle_state());
-                }
+                LUVVY_LOG(logger::level::debug, logger::make_cast(logger::event::cast_farm, spell->slot, 0, best_pos));
                 myhero->cast_spell(spell->slot, best_pos);
+                cast_tracker::issued(spell->slot);
                 return true;
             }
 
             if (spell->is_charging() && gametime->get_time() - spell->charging_started_time > 0.f)
             {
                 myhero->update_charged_spell(spell->slot, best_pos, true);
+                cast_tracker::issued(spell->slot);
                 return true;
             }
         }
@@ -213,6 +663,39 @@ namespace utils
         return false;
     }
 
+    bool cast(script_spell* spell)
+    {
+        if (!cast_tracker::can_cast(spell->slot) || !spell->cast())
+            return false;
+
+        LUVVY_LOG(logger::level::debug, logger::make_cast(logger::event::cast_self, spell->slot));
+        cast_tracker::issued(spell->slot);
+        tuner::on_cast(spell, vector(), nullptr);
+        return true;
+    }
+
+    bool cast(script_spell* spell, vector position)
+    {
+        if (!cast_tracker::can_cast(spell->slot) || !spell->cast(position))
+            return false;
+
+        LUVVY_LOG(logger::level::debug, logger::make_cast(logger::event::cast_position, spell->slot, 0, position));
+        cast_tracker::issued(spell->slot);
+        tuner::on_cast(spell, position, nullptr);
+        return true;
+    }
+
+    bool cast(script_spell* spell, game_object_script unit, hit_chance minimum, bool aoe, int min_targets)
+    {
+        if (!cast_tracker::can_cast(spell->slot) || !spell->cast(unit, minimum, aoe, min_targets))
+            return false;
+
+        LUVVY_LOG(logger::level::debug, logger::make_cast(logger::event::cast_unit, spell->slot, unit ? unit->get_network_id() : 0, unit ? unit->get_position() : vector()));
+        cast_tracker::issued(spell->slot);
+        tuner::on_cast(spell, vector(), unit);
+        return true;
+    }
+
     bool is_ready(spellslot slot)
     {
         auto spellInfo = myhero->get_spell(slot);
@@ -230,7 +713,208 @@ namespace utils
         return false;
     }
 
-    bool enabled_in_map(std::map<std::uint32_t, TreeEntry*> map, game_object_script target)
+    void build_minion_index()
+    {
+        float now = gametime->get_time();
+        if (minion_index::snapshot_time == now)
+            return;
+        minion_index::snapshot_time = now;
+
+        struct minion_entry
+        {
+            float x, y, radius;
+            game_object_script object;
+        };
+        static std::vector<minion_entry> entries;
+        entries.clear();
+        for (auto& minion : entitylist->get_enemy_minions())
+        {
+            if (!minion || !minion->is_valid() || minion->is_dead() || minion->is_ward())
+                continue;
+            auto pos = minion->get_position();
+            entries.push_back({ pos.x, pos.y, minion->get_bounding_radius(), minion });
+        }
+        std::sort(entries.begin(), entries.end(), [](const minion_entry& a, const minion_entry& b) {
+            return a.x < b.x;
+        });
+
+        size_t count = entries.size();
+        size_t padded = (count + 3) & ~size_t(3);
+        minion_index::objects.resize(count);
+        minion_index::xs.assign(padded, std::numeric_limits<float>::max());
+        minion_index::ys.assign(padded, 0.0f);
+        // Padding lanes get a negative radius so they can never hit
+        minion_index::radii.assign(padded, -minion_index::MAX_MINION_RADIUS);
+        for (size_t i = 0; i < count; ++i)
+        {
+            minion_index::xs[i] = entries[i].x;
+            minion_index::ys[i] = entries[i].y;
+            minion_index::radii[i] = entries[i].radius;
+            minion_index::objects[i] = entries[i].object;
+        }
+    }
+
+    // SSE scan of the current minion index; returns the first hit in x order other than `ignore`, or -1.
+    // The capsule ends `end_trim` short of `to` so units standing behind the target never count.
+    int find_blocking_index(const vector& from, const vector& to, float radius, float end_trim, const game_object_script& ignore)
+    {
+        auto& xs = minion_index::xs;
+        size_t count = minion_index::objects.size();
+        if (count == 0)
+            return -1;
+
+        float dx = to.x - from.x, dy = to.y - from.y;
+        float len = std::sqrt(dx * dx + dy * dy);
+        if (len <= end_trim)
+            return -1;
+        if (end_trim > 0.0f)
+        {
+            float scale = (len - end_trim) / len;
+            dx *= scale;
+            dy *= scale;
+        }
+        float end_x = from.x + dx;
+
+        float len_sq = dx * dx + dy * dy;
+        float inv_len_sq = len_sq > 0.0f ? 1.0f / len_sq : 0.0f;
+
+        // Only minions whose x lies inside the capsule's x extent can block, start at the first SSE block touching it
+        float min_x = std::min(from.x, end_x) - radius - minion_index::MAX_MINION_RADIUS;
+        float max_x = std::max(from.x, end_x) + radius + minion_index::MAX_MINION_RADIUS;
+        size_t first = std::lower_bound(xs.begin(), xs.begin() + count, min_x) - xs.begin();
+        first &= ~size_t(3);
+
+        const __m128 ax = _mm_set1_ps(from.x), ay = _mm_set1_ps(from.y);
+        const __m128 vdx = _mm_set1_ps(dx), vdy = _mm_set1_ps(dy);
+        const __m128 vinv = _mm_set1_ps(inv_len_sq), vradius = _mm_set1_ps(radius);
+        const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+
+        for (size_t i = first; i < count && xs[i] <= max_x; i += 4)
+        {
+            __m128 px = _mm_sub_ps(_mm_loadu_ps(&xs[i]), ax);
+            __m128 py = _mm_sub_ps(_mm_loadu_ps(&minion_index::ys[i]), ay);
+            __m128 t = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(px, vdx), _mm_mul_ps(py, vdy)), vinv);
+            t = _mm_min_ps(_mm_max_ps(t, zero), one);
+            __m128 cx = _mm_sub_ps(_mm_mul_ps(t, vdx), px);
+            __m128 cy = _mm_sub_ps(_mm_mul_ps(t, vdy), py);
+            __m128 dist_sq = _mm_add_ps(_mm_mul_ps(cx, cx), _mm_mul_ps(cy, cy));
+            __m128 reach = _mm_add_ps(vradius, _mm_loadu_ps(&minion_index::radii[i]));
+            __m128 hit = _mm_and_ps(_mm_cmplt_ps(dist_sq, _mm_mul_ps(reach, reach)), _mm_cmpgt_ps(reach, zero));
+
+            int mask = _mm_movemask_ps(hit);
+            while (mask)
+            {
+                int lane = 0;
+                while (!(mask & (1 << lane))) ++lane;
+                mask &= ~(1 << lane);
+
+                if (ignore && minion_index::objects[i + lane] == ignore)
+                    continue;
+                return static_cast<int>(i + lane);
+            }
+        }
+        return -1;
+    }
+
+    game_object_script find_blocking_minion(const vector& from, const vector& to, float radius, game_object_script ignore)
+    {
+        build_minion_index();
+
+        // The spell connects once it reaches the target's hitbox, anything past that point is behind it
+        float end_trim = ignore && ignore->is_valid() ? ignore->get_bounding_radius() : 0.0f;
+        int index = find_blocking_index(from, to, radius, end_trim, ignore);
+        if (index < 0)
+            return nullptr;
+
+        auto& blocker = minion_index::objects[index];
+        if (logger::is_active() && blocker->get_network_id() != minion_index::last_blocker_id)
+        {
+            minion_index::last_blocker_id = blocker->get_network_id();
+            LUVVY_LOG(logger::level::debug, logger::make_cast(logger::event::collision_block, spellslot::invalid, blocker->get_network_id(), vector(minion_index::xs[index], minion_index::ys[index])));
+        }
+        return blocker;
+    }
+
+    void run_collision_benchmark()
+    {
+        constexpr int MINIONS = 18; // three stacked waves around the lane
+        constexpr int QUERIES = 20000;
+        constexpr float RADIUS = 50.0f;
+
+        // The benchmark fills the index with a synthetic scene, the live snapshot is rebuilt on the next query
+        std::mt19937 rng(1337);
+        std::uniform_real_distribution<float> coord(0.0f, 1200.0f);
+        std::uniform_real_distribution<float> radius(48.0f, 65.0f);
+        std::vector<vector> minions(MINIONS);
+        std::vector<float> radii(MINIONS);
+        for (int i = 0; i < MINIONS; ++i)
+        {
+            minions[i] = vector(coord(rng), coord(rng));
+            radii[i] = radius(rng);
+        }
+        std::vector<int> order(MINIONS);
+        for (int i = 0; i < MINIONS; ++i)
+            order[i] = i;
+        std::sort(order.begin(), order.end(), [&minions](int a, int b) { return minions[a].x < minions[b].x; });
+
+        size_t padded = (MINIONS + 3) & ~size_t(3);
+        minion_index::objects.assign(MINIONS, nullptr);
+        minion_index::xs.assign(padded, std::numeric_limits<float>::max());
+        minion_index::ys.assign(padded, 0.0f);
+        minion_index::radii.assign(padded, -minion_index::MAX_MINION_RADIUS);
+        for (int i = 0; i < MINIONS; ++i)
+        {
+            minion_index::xs[i] = minions[order[i]].x;
+            minion_index::ys[i] = minions[order[i]].y;
+            minion_index::radii[i] = radii[order[i]];
+        }
+
+        std::vector<std::pair<vector, vector>> queries(QUERIES);
+        for (auto& query : queries)
+            query = { vector(coord(rng), coord(rng)), vector(coord(rng), coord(rng)) };
+
+        // Scalar reference, counts a minion only when its closest point on the trimmed segment is in reach
+        auto reference_blocked = [&](const vector& from, const vector& to, float end_trim) {
+            float dx = to.x - from.x, dy = to.y - from.y;
+            float len = std::sqrt(dx * dx + dy * dy);
+            if (len <= end_trim)
+                return false;
+            float ex = dx * (len - end_trim) / len, ey = dy * (len - end_trim) / len;
+            float len_sq = ex * ex + ey * ey;
+            for (int i = 0; i < MINIONS; ++i)
+            {
+                float px = minion_index::xs[i] - from.x, py = minion_index::ys[i] - from.y;
+                float t = len_sq > 0.0f ? std::min(std::max((px * ex + py * ey) / len_sq, 0.0f), 1.0f) : 0.0f;
+                float cx = t * ex - px, cy = t * ey - py;
+                float reach = RADIUS + minion_index::radii[i];
+                if (cx * cx + cy * cy < reach * reach)
+                    return true;
+            }
+            return false;
+        };
+
+        int mismatches = 0;
+        for (auto& query : queries)
+        {
+            bool fast = find_blocking_index(query.first, query.second, RADIUS, 65.0f, nullptr) >= 0;
+            mismatches += fast != reference_blocked(query.first, query.second, 65.0f) ? 1 : 0;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        int hits = 0;
+        for (auto& query : queries)
+            hits += find_blocking_index(query.first, query.second, RADIUS, 65.0f, nullptr) >= 0 ? 1 : 0;
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / QUERIES;
+
+        minion_index::snapshot_time = -1.0f;
+        minion_index::objects.clear();
+
+        console->print("[luvvy] collision benchmark: %d minions, %.1f ns per check, %d/%d blocked, %s",
+            MINIONS, ns, hits, QUERIES, mismatches == 0 ? "matches scalar" : "MISMATCH");
+        LUVVY_LOG(logger::level::info, logger::make_message("collision benchmark ns per check", static_cast<std::int32_t>(ns)));
+    }
+
+    bool enabled_in_map(const std::map<std::uint32_t, TreeEntry*>& map, const game_object_script& target)
     {
         auto it = map.find(target->get_network_id());
         if (it == map.end())
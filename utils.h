@@ -1,14 +1,95 @@
 #include "../plugin_sdk/plugin_sdk.hpp"
+#include <vector>
 
 #pragma once
 namespace utils
 {
+	// Frame arena
+	//
+	// Bump-pointer scratch memory reset at the start of every tick. Anything allocated
+	// from it is only valid until the next on_update, never keep it across ticks.
+	void frame_arena_load();
+	void frame_arena_unload();
+	void frame_arena_reset();
+	void* frame_arena_allocate(std::size_t bytes, std::size_t alignment);
+
+	template <class T>
+	struct frame_allocator
+	{
+		using value_type = T;
+
+		frame_allocator() = default;
+		template <class U>
+		frame_allocator(const frame_allocator<U>&) {}
+
+		T* allocate(std::size_t n) { return static_cast<T*>(frame_arena_allocate(n * sizeof(T), alignof(T))); }
+		void deallocate(T*, std::size_t) {}
+
+		template <class U>
+		bool operator==(const frame_allocator<U>&) const { return true; }
+		template <class U>
+		bool operator!=(const frame_allocator<U>&) const { return false; }
+	};
+
+	template <class T>
+	using frame_vector = std::vector<T, frame_allocator<T>>;
+
+	// Non-owning view over contiguous elements
+	template <class T>
+	struct span
+	{
+		T* ptr = nullptr;
+		std::size_t count = 0;
+
+		span() = default;
+		span(T* data, std::size_t size) : ptr(data), count(size) {}
+		template <class Container>
+		span(Container& c) : ptr(c.data()), count(c.size()) {}
+
+		T* begin() const { return ptr; }
+		T* end() const { return ptr + count; }
+		T& operator[](std::size_t i) const { return ptr[i]; }
+		std::size_t size() const { return count; }
+		bool empty() const { return count == 0; }
+	};
+
+	// Entity handles
+	//
+	// Generation-checked reference for objects kept across ticks. The slot is recycled when the
+	// object is deleted and its generation bumped, so a stale handle resolves to nullptr instead of
+	// to whatever object reused the memory or network id.
+	struct entity_handle
+	{
+		static constexpr std::uint16_t INVALID_INDEX = 0xFFFF;
+
+		std::uint16_t index = INVALID_INDEX;
+		std::uint16_t generation = 0;
+
+		bool is_set() const { return index != INVALID_INDEX; }
+		// Unset handles never compare equal, not even to each other
+		bool operator==(const entity_handle& other) const { return is_set() && index == other.index && generation == other.generation; }
+		bool operator!=(const entity_handle& other) const { return !(*this == other); }
+	};
+
+	void handles_load();
+	void handles_unload();
+	// Same handle for the same live object; unset handle when the table is full
+	entity_handle make_handle(const game_object_script& unit);
+	// Handle of an object already in the table, unset otherwise; never inserts
+	entity_handle lookup_handle(const game_object_script& unit);
+	// nullptr once the object was deleted, dead but not yet deleted units still resolve
+	game_object_script resolve(entity_handle handle);
+
 	// line add
 	int count_enemy_minions_in_range(float range, const vector& pos);
 
 	// AIO utilities
 	//
+	void on_load(TreeTab* champion_tab);
+	// Champions without a menu tab (no developer settings)
 	void on_load();
+	// Monotonic tick id, advanced at the start of every on_update
+	std::uint64_t get_tick();
 
 	// Buff checks
 	//
@@ -25,13 +106,25 @@ namespace utils
 	bool cast(spellslot slot, vector position, bool is_charged_spell);
 	bool fast_cast(script_spell* spell, game_object_script unit, hit_chance minimum, bool aoe, int min_targets);
 	bool fast_cast(script_spell* spell, int minMinions, bool is_jugnle_mobs);
+	// script_spell casts through the cast tracker: throttled per slot and recorded once the SDK accepted them
+	bool cast(script_spell* spell);
+	bool cast(script_spell* spell, vector position);
+	bool cast(script_spell* spell, game_object_script unit, hit_chance minimum = hit_chance::medium, bool aoe = false, int min_targets = 0);
 
 	// Spell utilities
 	//
 	bool is_ready(spellslot slot);
+
+	// Collision precheck
+	//
+	// Capsule test from `from` to `to` with the skillshot radius against enemy minions; returns the first minion that clearly blocks the path.
+	// With `ignore` set the capsule stops at its bounding radius, so minions behind the target never block.
+	game_object_script find_blocking_minion(const vector& from, const vector& to, float radius, game_object_script ignore = nullptr);
+	// Developer benchmark: times the precheck on a synthetic wave and checks it against a scalar test
+	void run_collision_benchmark();
 	
 	// Other
 	//
-	bool enabled_in_map(std::map<std::uint32_t, TreeEntry*> map, game_object_script target);
+	bool enabled_in_map(const std::map<std::uint32_t, TreeEntry*>& map, const game_object_script& target);
 };
 
@@ -0,0 +1,144 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+#include "watchdog.h"
+#include <algorithm>
+
+namespace watchdog
+{
+    static module_stats modules[MAX_MODULES];
+    static int module_count = 0;
+    static level current = level::full;
+    static float budget_ms = DEFAULT_BUDGET_MS;
+    static float average_ms = 0.0f;
+    static int over_ticks = 0;
+    static int under_ticks = 0;
+    static std::uint64_t ticks = 0;
+
+    static int find_module(const char* name)
+    {
+        // Module names are string literals, pointer identity is enough
+        for (int i = 0; i < module_count; ++i)
+        {
+            if (modules[i].name == name)
+                return i;
+        }
+        if (module_count == MAX_MODULES)
+            return -1;
+        modules[module_count].name = name;
+        return module_count++;
+    }
+
+    scope::scope(const char* name) : index(find_module(name)), start(std::chrono::steady_clock::now())
+    {
+    }
+
+    scope::~scope()
+    {
+        if (index < 0)
+            return;
+        modules[index].current_ms += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void set_budget_ms(float value)
+    {
+        budget_ms = std::max(value, 0.1f);
+    }
+
+    float get_budget_ms()
+    {
+        return budget_ms;
+    }
+
+    bool end_tick(transition* out)
+    {
+        ++ticks;
+
+        float total = 0.0f;
+        const module_stats* worst = nullptr;
+        for (int i = 0; i < module_count; ++i)
+        {
+            auto& m = modules[i];
+            m.average_ms += (m.current_ms - m.average_ms) * EMA_ALPHA;
+            m.last_ms = m.current_ms;
+            m.current_ms = 0.0f;
+            total += m.average_ms;
+            if (!worst || m.average_ms > worst->average_ms)
+                worst = &m;
+        }
+        average_ms = total;
+
+        over_ticks = average_ms > budget_ms ? over_ticks + 1 : 0;
+        under_ticks = average_ms < budget_ms * RECOVER_RATIO ? under_ticks + 1 : 0;
+
+        level next = current;
+        if (over_ticks >= STEP_DOWN_TICKS && current < level::cheap_prediction)
+        {
+            next = static_cast<level>(static_cast<int>(current) + 1);
+            over_ticks = 0;
+        }
+        else if (under_ticks >= STEP_UP_TICKS && current > level::full)
+        {
+            next = static_cast<level>(static_cast<int>(current) - 1);
+            under_ticks = 0;
+        }
+
+        if (next == current)
+            return false;
+
+        if (out)
+            *out = { current, next, average_ms, worst ? worst->name : nullptr };
+        current = next;
+        return true;
+    }
+
+    float get_average_ms()
+    {
+        return average_ms;
+    }
+
+    const module_stats* get_modules(int* count)
+    {
+        if (count)
+            *count = module_count;
+        return modules;
+    }
+
+    level get_level()
+    {
+        return current;
+    }
+
+    const char* get_level_name(level value)
+    {
+        switch (value)
+        {
+            case level::full: return "full";
+            case level::slow_farm: return "slow farm";
+            case level::no_range_circles: return "no range circles";
+            case level::frozen_permashow: return "frozen permashow";
+            case level::cheap_prediction: return "cheap prediction";
+            default: return "unknown";
+        }
+    }
+
+    bool should_run_farm()
+    {
+        return current < level::slow_farm || ticks % FARM_TICK_DIVISOR == 0;
+    }
+
+    bool draw_range_circles()
+    {
+        return current < level::no_range_circles;
+    }
+
+    bool update_permashow_layout()
+    {
+        return current < level::frozen_permashow;
+    }
+
+    hit_chance clamp_hitchance(hit_chance value)
+    {
+        if (current < level::cheap_prediction)
+            return value;
+        return std::min(value, hit_chance::medium);
+    }
+}
@@ -0,0 +1,73 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+#include <chrono>
+
+#pragma once
+namespace watchdog
+{
+    // Each level also keeps every cheaper level before it
+    enum class level : int
+    {
+        full = 0,
+        slow_farm,          // farm solvers only run every FARM_TICK_DIVISOR ticks
+        no_range_circles,   // champions skip their range circles in on_draw
+        frozen_permashow,   // permashow keeps its last layout
+        cheap_prediction,   // skillshot hitchance capped at medium
+        count
+    };
+
+    constexpr int MAX_MODULES = 16;
+    constexpr float DEFAULT_BUDGET_MS = 2.0f;
+    constexpr float EMA_ALPHA = 0.1f;
+    // Levels are only restored once the average is well under budget
+    constexpr float RECOVER_RATIO = 0.6f;
+    constexpr int STEP_DOWN_TICKS = 10;
+    constexpr int STEP_UP_TICKS = 150;
+    constexpr int FARM_TICK_DIVISOR = 3;
+
+    struct module_stats
+    {
+        const char* name = nullptr;
+        float current_ms = 0.0f;
+        float average_ms = 0.0f;
+        // Previous tick's time, kept for telemetry after current_ms is reset
+        float last_ms = 0.0f;
+    };
+
+    struct transition
+    {
+        level from = level::full;
+        level to = level::full;
+        float average_ms = 0.0f;
+        const char* worst_module = nullptr;
+    };
+
+    // Settings
+    //
+    void set_budget_ms(float budget_ms);
+    float get_budget_ms();
+
+    // Tick accounting, driven from the frame start callback. Returns true when the level changed.
+    //
+    bool end_tick(transition* out = nullptr);
+    float get_average_ms();
+    const module_stats* get_modules(int* count);
+
+    // Queries for the optional work
+    //
+    level get_level();
+    const char* get_level_name(level value);
+    bool should_run_farm();
+    bool draw_range_circles();
+    bool update_permashow_layout();
+    hit_chance clamp_hitchance(hit_chance value);
+
+    // Scoped timer: attributes the time spent inside the scope to `name` (a string literal)
+    struct scope
+    {
+        explicit scope(const char* name);
+        ~scope();
+
+        int index;
+        std::chrono::steady_clock::time_point start;
+    };
+};
@@ -0,0 +1,335 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+#include "waves.h"
+#include "utils.h"
+#include "alloc_counter.h"
+#include "watchdog.h"
+#include <algorithm>
+#include <cmath>
+
+namespace waves
+{
+    // Deletes are matched by network id, the handle is already stale when they arrive
+    struct tracked_minion
+    {
+        utils::entity_handle handle;
+        std::uint32_t network_id = 0;
+        float x = 0.0f;
+        float y = 0.0f;
+        std::int64_t cell = 0;
+        int cluster = -1;
+    };
+
+    static tracked_minion minions[MAX_MINIONS];
+    static int minion_count = 0;
+    // Set when a minion spawned, died or crossed into another cell
+    static bool membership_dirty = false;
+    // Clusters that lost a member (death or cell change) and may have split. Minions that spawned or
+    // changed cell carry cluster -1 until the next rebuild.
+    static bool cluster_dirty[MAX_MINIONS];
+
+    static cluster clusters[MAX_MINIONS];
+    static int cluster_count = 0;
+    static game_object_script members[MAX_MINIONS];
+
+    static std::int64_t make_cell(std::int64_t cx, std::int64_t cy)
+    {
+        return (cx << 32) ^ (cy & 0xffffffff);
+    }
+
+    static std::int64_t cell_of(float x, float y)
+    {
+        return make_cell(static_cast<std::int64_t>(std::floor(x / CELL_SIZE)), static_cast<std::int64_t>(std::floor(y / CELL_SIZE)));
+    }
+
+    static void add_minion(game_object_script minion)
+    {
+        if (minion_count == MAX_MINIONS)
+            return;
+
+        auto id = minion->get_network_id();
+        for (int i = 0; i < minion_count; ++i)
+        {
+            if (minions[i].network_id == id)
+                return;
+        }
+
+        auto pos = minion->get_position();
+        auto handle = utils::make_handle(minion);
+        if (!handle.is_set())
+            return;
+        minions[minion_count++] = { handle, id, pos.x, pos.y, cell_of(pos.x, pos.y), -1 };
+        membership_dirty = true;
+    }
+
+    static void remove_at(int index)
+    {
+        if (minions[index].cluster >= 0)
+            cluster_dirty[minions[index].cluster] = true;
+        minions[index] = minions[--minion_count];
+        minions[minion_count] = tracked_minion{};
+        membership_dirty = true;
+    }
+
+    void on_create_object(game_object_script sender)
+    {
+        if (sender && sender->is_valid() && sender->is_lane_minion() && sender->is_enemy())
+            add_minion(sender);
+    }
+
+    void on_delete_object(game_object_script sender)
+    {
+        if (!sender || !sender->is_lane_minion())
+            return;
+
+        auto id = sender->get_network_id();
+        for (int i = 0; i < minion_count; ++i)
+        {
+            if (minions[i].network_id == id)
+            {
+                remove_at(i);
+                return;
+            }
+        }
+    }
+
+    // Occupied cells hashed to chains of minion indices, rebuilt with the clusters
+    constexpr int CELL_BUCKETS = 256; // power of two, at least 2 * MAX_MINIONS
+    static int bucket_head[CELL_BUCKETS];
+    static int bucket_next[MAX_MINIONS];
+
+    static int bucket_of(std::int64_t cell)
+    {
+        return static_cast<int>((static_cast<std::uint64_t>(cell) * 0x9E3779B97F4A7C15ull) >> 56) & (CELL_BUCKETS - 1);
+    }
+
+    // Calls fn(j) for every minion in the 3x3 cells around `cell`
+    template <class F>
+    static void for_each_neighbour(std::int64_t cell, F&& fn)
+    {
+        auto cx = cell >> 32;
+        auto cy = static_cast<std::int64_t>(static_cast<std::int32_t>(cell & 0xffffffff));
+        for (std::int64_t dx = -1; dx <= 1; ++dx)
+        {
+            for (std::int64_t dy = -1; dy <= 1; ++dy)
+            {
+                auto neighbour = make_cell(cx + dx, cy + dy);
+                for (int j = bucket_head[bucket_of(neighbour)]; j >= 0; j = bucket_next[j])
+                {
+                    if (minions[j].cell == neighbour)
+                        fn(j);
+                }
+            }
+        }
+    }
+
+    // Connected components over occupied cells, recomputed only for touched clusters: the ones that
+    // lost a member, the loose minions, and the clean clusters next to those. Clean clusters never touch
+    // each other, so one pass finds all of them. Cost is linear in the minions plus the touched part.
+    static void rebuild_clusters()
+    {
+        std::fill(bucket_head, bucket_head + CELL_BUCKETS, -1);
+        for (int i = 0; i < minion_count; ++i)
+        {
+            int bucket = bucket_of(minions[i].cell);
+            bucket_next[i] = bucket_head[bucket];
+            bucket_head[bucket] = i;
+        }
+
+        bool touched[MAX_MINIONS];
+        int queue[MAX_MINIONS];
+        int queued = 0;
+        for (int i = 0; i < minion_count; ++i)
+        {
+            touched[i] = minions[i].cluster < 0 || cluster_dirty[minions[i].cluster];
+            if (touched[i])
+                queue[queued++] = i;
+        }
+        for (int q = 0; q < queued; ++q)
+        {
+            for_each_neighbour(minions[queue[q]].cell, [](int j) {
+                if (minions[j].cluster >= 0)
+                    cluster_dirty[minions[j].cluster] = true;
+            });
+        }
+        for (int i = 0; i < minion_count; ++i)
+            touched[i] = minions[i].cluster < 0 || cluster_dirty[minions[i].cluster];
+
+        // Untouched clusters keep their members, ids are compacted
+        int remap[MAX_MINIONS];
+        std::fill(remap, remap + MAX_MINIONS, -1);
+        int next_id = 0;
+        for (int i = 0; i < minion_count; ++i)
+        {
+            if (touched[i])
+            {
+                minions[i].cluster = -1;
+                continue;
+            }
+            auto& id = remap[minions[i].cluster];
+            if (id < 0)
+                id = next_id++;
+            minions[i].cluster = id;
+        }
+
+        // Flood fill over the touched minions through neighbouring cells
+        for (int seed = 0; seed < minion_count; ++seed)
+        {
+            if (!touched[seed] || minions[seed].cluster >= 0)
+                continue;
+
+            int id = next_id++;
+            minions[seed].cluster = id;
+            queued = 0;
+            queue[queued++] = seed;
+            for (int q = 0; q < queued; ++q)
+            {
+                for_each_neighbour(minions[queue[q]].cell, [&](int j) {
+                    if (touched[j] && minions[j].cluster < 0)
+                    {
+                        minions[j].cluster = id;
+                        queue[queued++] = j;
+                    }
+                });
+            }
+        }
+
+        cluster_count = next_id;
+        std::fill(cluster_dirty, cluster_dirty + MAX_MINIONS, false);
+        membership_dirty = false;
+    }
+
+    void on_update()
+    {
+        alloc_counter::probe probe("waves::on_update");
+        watchdog::scope timer("waves::on_update");
+
+        // Positions and deaths; only a cell change marks membership dirty
+        for (int i = 0; i < minion_count;)
+        {
+            auto& m = minions[i];
+            auto object = utils::resolve(m.handle);
+            if (!object || !object->is_valid() || object->is_dead())
+            {
+                remove_at(i);
+                continue;
+            }
+
+            auto pos = object->get_position();
+            m.x = pos.x;
+            m.y = pos.y;
+            auto cell = cell_of(pos.x, pos.y);
+            if (cell != m.cell)
+            {
+                if (m.cluster >= 0)
+                    cluster_dirty[m.cluster] = true;
+                m.cell = cell;
+                m.cluster = -1;
+                membership_dirty = true;
+            }
+            ++i;
+        }
+
+        if (membership_dirty)
+            rebuild_clusters();
+
+        // Summaries: member offsets by counting sort, then centroid, health and bounding radius
+        for (int c = 0; c < cluster_count; ++c)
+            clusters[c] = cluster{};
+        for (int i = 0; i < minion_count; ++i)
+            clusters[minions[i].cluster].count++;
+        for (int c = 1; c < cluster_count; ++c)
+            clusters[c].first = clusters[c - 1].first + clusters[c - 1].count;
+
+        int fill[MAX_MINIONS] = {};
+        for (int i = 0; i < minion_count; ++i)
+        {
+            const auto& m = minions[i];
+            auto& c = clusters[m.cluster];
+            auto object = utils::resolve(m.handle);
+            members[c.first + fill[m.cluster]++] = object;
+            c.x += m.x;
+            c.y += m.y;
+            c.total_health += object->get_health();
+        }
+        for (int c = 0; c < cluster_count; ++c)
+        {
+            clusters[c].x /= clusters[c].count;
+            clusters[c].y /= clusters[c].count;
+        }
+        for (int i = 0; i < minion_count; ++i)
+        {
+            auto& c = clusters[minions[i].cluster];
+            float dx = minions[i].x - c.x, dy = minions[i].y - c.y;
+            c.radius = std::max(c.radius, std::sqrt(dx * dx + dy * dy));
+        }
+    }
+
+    void load()
+    {
+        minion_count = 0;
+        cluster_count = 0;
+        std::fill(cluster_dirty, cluster_dirty + MAX_MINIONS, false);
+        for (auto& minion : entitylist->get_enemy_minions())
+        {
+            if (minion && minion->is_valid() && !minion->is_dead() && minion->is_lane_minion())
+                add_minion(minion);
+        }
+
+        event_handler<events::on_create_object>::add_callback(on_create_object);
+        event_handler<events::on_delete_object>::add_callback(on_delete_object);
+        event_handler<events::on_update>::add_callback(on_update);
+    }
+
+    void unload()
+    {
+        event_handler<events::on_create_object>::remove_handler(on_create_object);
+        event_handler<events::on_delete_object>::remove_handler(on_delete_object);
+        event_handler<events::on_update>::remove_handler(on_update);
+        for (int i = 0; i < minion_count; ++i)
+            minions[i] = tracked_minion{};
+        std::fill(members, members + MAX_MINIONS, nullptr);
+        minion_count = 0;
+        cluster_count = 0;
+    }
+
+    const cluster* get_clusters(int* count)
+    {
+        if (count)
+            *count = cluster_count;
+        return clusters;
+    }
+
+    const game_object_script* get_members(const cluster& value)
+    {
+        return members + value.first;
+    }
+
+    bool reaches(const cluster& value, const vector& pos, float range)
+    {
+        float dx = value.x - pos.x, dy = value.y - pos.y;
+        float reach = range + value.radius;
+        return dx * dx + dy * dy <= reach * reach;
+    }
+
+    int count_in_range(const vector& pos, float range)
+    {
+        int total = 0;
+        for (int c = 0; c < cluster_count; ++c)
+        {
+            if (reaches(clusters[c], pos, range))
+                total += clusters[c].count;
+        }
+        return total;
+    }
+
+    int largest_in_range(const vector& pos, float range)
+    {
+        int largest = 0;
+        for (int c = 0; c < cluster_count; ++c)
+        {
+            if (reaches(clusters[c], pos, range))
+                largest = std::max(largest, clusters[c].count);
+        }
+        return largest;
+    }
+}
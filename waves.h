@@ -0,0 +1,35 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+
+#pragma once
+namespace waves
+{
+    // Minions in the same or neighbouring cells belong to one cluster, so a circle with radius up to
+    // CELL_SIZE / 2 never hits two clusters at once
+    constexpr float CELL_SIZE = 300.0f;
+    constexpr int MAX_MINIONS = 128;
+
+    struct cluster
+    {
+        float x = 0.0f;             // centroid
+        float y = 0.0f;
+        float radius = 0.0f;        // bounding circle around the centroid
+        int count = 0;
+        float total_health = 0.0f;
+        int first = 0;              // into get_members()
+    };
+
+    // Clusterer lifetime, fed by object create/delete events and one position pass per tick
+    //
+    void load();
+    void unload();
+
+    // Queries over the enemy lane minion clusters of the current tick
+    //
+    const cluster* get_clusters(int* count);
+    const game_object_script* get_members(const cluster& value);
+    bool reaches(const cluster& value, const vector& pos, float range);
+    // Upper bound of the minions within `range` of `pos`
+    int count_in_range(const vector& pos, float range);
+    // Largest cluster reaching within `range` of `pos`
+    int largest_in_range(const vector& pos, float range);
+};
@@ -0,0 +1,118 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+#include "worker.h"
+#include "parallel.h"
+#include <thread>
+#include <chrono>
+
+namespace worker
+{
+    constexpr auto IDLE_SLEEP = std::chrono::milliseconds(1);
+
+    static latest_value<snapshot> snapshots;
+    static latest_value<farm_result> results;
+    static std::thread thread;
+    static std::atomic<bool> running{ false };
+
+    void worker_loop()
+    {
+        while (running.load(std::memory_order_acquire))
+        {
+            auto snap = snapshots.read();
+            if (!snap)
+            {
+                std::this_thread::sleep_for(IDLE_SLEEP);
+                continue;
+            }
+
+            results.write_slot() = solve_circle_farm(*snap);
+            results.publish();
+        }
+    }
+
+    void set_enabled(bool enabled)
+    {
+        if (enabled == running.load(std::memory_order_relaxed))
+            return;
+
+        if (enabled)
+        {
+            running.store(true, std::memory_order_release);
+            thread = std::thread(worker_loop);
+        }
+        else
+        {
+            running.store(false, std::memory_order_release);
+            if (thread.joinable())
+                thread.join();
+        }
+    }
+
+    bool is_enabled()
+    {
+        return running.load(std::memory_order_relaxed);
+    }
+
+    void unload()
+    {
+        set_enabled(false);
+    }
+
+    snapshot& begin_snapshot()
+    {
+        auto& snap = snapshots.write_slot();
+        snap.minion_count = 0;
+        return snap;
+    }
+
+    void publish_snapshot()
+    {
+        snapshots.publish();
+    }
+
+    bool get_farm_result(std::uint64_t current_tick, farm_result& out)
+    {
+        auto fresh = results.read();
+        const auto& result = fresh ? *fresh : results.last_read();
+        if (result.tick == 0 || result.tick + MAX_RESULT_AGE < current_tick)
+            return false;
+        out = result;
+        return true;
+    }
+
+    farm_result solve_circle_farm(const snapshot& snap)
+    {
+        farm_result best;
+        best.tick = snap.tick;
+
+        parallel::circle_point units[MAX_UNITS];
+        parallel::circle_point centers[MAX_UNITS];
+        int center_index[MAX_UNITS];
+        int counts[MAX_UNITS];
+        float scores[MAX_UNITS];
+
+        float range_sq = snap.farm_range * snap.farm_range;
+        int center_count = 0;
+        for (int i = 0; i < snap.minion_count; ++i)
+        {
+            const auto& m = snap.minions[i];
+            units[i] = { m.x, m.y, m.killable };
+
+            float hx = m.x - snap.hero_x, hy = m.y - snap.hero_y;
+            if (hx * hx + hy * hy > range_sq)
+                continue;
+            center_index[center_count] = i;
+            centers[center_count++] = units[i];
+        }
+
+        parallel::score_circles(centers, center_count, units, snap.minion_count, snap.farm_radius, snap.farm_kill_weight, counts, scores);
+        int pick = parallel::pick_best(scores, center_count);
+        if (pick < 0)
+            return best;
+
+        best.index = center_index[pick];
+        best.handle = snap.minions[best.index].handle;
+        best.count = counts[pick];
+        best.score = scores[pick];
+        return best;
+    }
+}
@@ -0,0 +1,94 @@
+#include "../plugin_sdk/plugin_sdk.hpp"
+#include "utils.h"
+#include <atomic>
+
+#pragma once
+namespace worker
+{
+    constexpr int MAX_UNITS = 256;
+    constexpr std::uint64_t MAX_RESULT_AGE = 2; // ticks
+
+    // Plain data only, nothing in here may touch the SDK
+    struct unit_data
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+        utils::entity_handle handle;
+        bool killable = false;
+    };
+
+    struct snapshot
+    {
+        std::uint64_t tick = 0;
+        float hero_x = 0.0f;
+        float hero_y = 0.0f;
+
+        // Circle AoE farm query: best minion to center a `radius` circle on within `range`
+        float farm_range = 0.0f;
+        float farm_radius = 0.0f;
+        float farm_kill_weight = 0.0f;
+
+        int minion_count = 0;
+        unit_data minions[MAX_UNITS];
+    };
+
+    struct farm_result
+    {
+        std::uint64_t tick = 0;
+        int index = -1;
+        utils::entity_handle handle;
+        int count = 0;
+        float score = 0.0f;
+    };
+
+    // Lock-free single producer / single consumer handoff of the latest value (triple buffer:
+    // the producer and consumer each own one slot and swap through the middle one)
+    template <class T>
+    class latest_value
+    {
+    public:
+        T& write_slot() { return slots[back]; }
+
+        void publish()
+        {
+            back = middle.exchange(static_cast<std::uint8_t>(back | FRESH), std::memory_order_acq_rel) & INDEX;
+        }
+
+        // Returns nullptr when nothing new was published since the last read
+        const T* read()
+        {
+            if (!(middle.load(std::memory_order_relaxed) & FRESH))
+                return nullptr;
+            front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+            return &slots[front];
+        }
+
+        const T& last_read() const { return slots[front]; }
+
+    private:
+        static constexpr std::uint8_t FRESH = 0x4;
+        static constexpr std::uint8_t INDEX = 0x3;
+
+        T slots[3];
+        std::uint8_t back = 0;
+        std::atomic<std::uint8_t> middle{ 1 };
+        std::uint8_t front = 2;
+    };
+
+    // Worker lifetime, the thread only runs while worker mode is enabled
+    //
+    void unload();
+    void set_enabled(bool enabled);
+    bool is_enabled();
+
+    // Game thread side
+    //
+    snapshot& begin_snapshot();
+    void publish_snapshot();
+    // Latest result if it belongs to a snapshot no older than MAX_RESULT_AGE ticks
+    bool get_farm_result(std::uint64_t current_tick, farm_result& out);
+
+    // Solvers, shared by the worker and the serial path so both give identical answers
+    //
+    farm_result solve_circle_farm(const snapshot& snap);
+};
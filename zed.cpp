@@ -1,11 +1,21 @@
 #include "../plugin_sdk/plugin_sdk.hpp"
 #include "zed.h"
 #include "utils.h"
+#include "alloc_counter.h"
+#include "logger.h"
+#include "watchdog.h"
 #include "permashow.hpp"
+#include "forecast.h"
+#include "minion_health.h"
+#include "spell_data.h"
+#include "movement.h"
+#include "jungle.h"
+#include "waves.h"
+#include "hero_table.h"
+#include "tuner.h"
 #include <vector>
 #include <algorithm>
 #include <string>
-#include <map>
 
 namespace zed
 {
@@ -45,6 +55,9 @@ namespace zed
     TreeEntry* killsteal_e = nullptr;
     TreeEntry* killsteal_r = nullptr;
 
+    // Dodge lethal damage / hard-CC ults with R
+    TreeEntry* defensive_r = nullptr;
+
     // Draw
     TreeEntry* draw_q_range = nullptr;
     TreeEntry* draw_w_range = nullptr;
@@ -55,8 +68,8 @@ namespace zed
     TreeEntry* w2_auto_cast_toggle = nullptr;
     bool allow_w2_cast = true; // Updated every frame from permashow toggle
 
-    // R blacklist per enemy champ to disable R usage
-    std::map<std::string, TreeEntry*> r_blacklist_entries;
+    // R blacklist per enemy champ to disable R usage, one dense slot per hero
+    hero_table::column r_allowed;
 
     // ShadowRunner buff hash for shadow detection
     static const uint32_t SHADOWRUNNER_BUFF_HASH = 0xD5F12997;
@@ -144,129 +157,288 @@ namespace zed
     {
         if (!target || !target->is_valid()) return false;
 
-        std::string name = target->get_model();
-        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+        return hero_table::get_bool(r_allowed, target, true);
+    }
 
-        auto it = r_blacklist_entries.find(name);
-        if (it != r_blacklist_entries.end() && it->second && !it->second->get_bool())
-            return false;
+    // --- Cheap minion collision precheck so blocked Q casts skip SDK prediction ---
+    bool q_path_blocked(game_object_script target)
+    {
+        return utils::find_blocking_minion(myhero->get_position(), target->get_position(), spell_data::zed::Q.width, target) != nullptr;
+    }
 
-        return true;
+    // Tracked-path intercept, skips the SDK prediction for targets that will walk out of Q range
+    bool q_in_reach(game_object_script target)
+    {
+        return movement::can_reach(target, myhero->get_position(), spell_data::zed::Q);
     }
 
-    // --- Dangerous ult detection to auto-cast R defensively ---
-    bool is_dangerous_spell(spellslot slot, const std::string& caster_name)
+    // --- Defensive R ---
+    // Both triggers come from the forecast: lethal incoming damage, or a hard-CC ult from one of these
+    // champions about to land on Zed
+    constexpr float DEFENSIVE_R_WINDOW = 0.5f;
+
+    bool is_dangerous_caster(const game_object_script& sender)
     {
-        static std::set<std::string> dangerous_casters = {
+        static const char* dangerous_casters[] = {
             "fizz", "diana", "maokai", "morgana", "malphite", "veigar", "vi",
             "leona", "riven", "warwick", "nocturne", "nautilus"
         };
-        static std::set<spellslot> dangerous_slots = { spellslot::r };
-        return dangerous_casters.count(caster_name) && dangerous_slots.count(slot);
-    }
-
-    void on_process_spell_cast(game_object_script sender, spell_instance_script spell)
-    {
-        if (!sender || sender->is_ally()) return;
-
         std::string caster = sender->get_model();
         std::transform(caster.begin(), caster.end(), caster.begin(), ::tolower);
-        spellslot slot = spell->get_spellslot();
-
-        if (is_dangerous_spell(slot, caster) && r->is_ready())
+        for (auto name : dangerous_casters)
         {
-            auto evade_target = target_selector->get_target(r->range(), damage_type::physical);
-            if (evade_target && evade_target->is_valid_target(r->range()))
-                r->cast(evade_target);
+            if (caster == name)
+                return true;
         }
+        return false;
     }
 
-    // --- Combo Logic: Simple All-in only ---
-    void combo_simple_allin(game_object_script target)
+    void defensive_r_logic()
     {
-        bool save_q_for_r = combo_save_q_for_r && combo_save_q_for_r->get_bool();
-        int q_hold_range = combo_q_hold_range ? combo_q_hold_range->get_int() : 400;
-        int swap_back_delay_ticks = combo_swap_back_delay ? combo_swap_back_delay->get_int() : 7;
-        float swap_back_delay = swap_back_delay_ticks * 0.1f;
+        if (!defensive_r || !defensive_r->get_bool() || !r->is_ready()) return;
+        bool lethal = forecast::get_incoming_damage(myhero, DEFENSIVE_R_WINDOW) >= myhero->get_health();
+        if (!lethal && !forecast::has_incoming_spell(myhero, spellslot::r, DEFENSIVE_R_WINDOW, is_dangerous_caster)) return;
 
-        static float last_combo_time = 0;
-        static float last_w_cast_time = 0;  // For W cooldown when toggle OFF
-        static bool can_swap_back = false;
+        auto evade_target = target_selector->get_target(r->range(), damage_type::physical);
+        if (evade_target && evade_target->is_valid_target(r->range()))
+            utils::cast(r, evade_target);
+    }
 
-        float now = gametime->get_time();
-        bool shadow_deployed = myhero->has_buff(SHADOWRUNNER_BUFF_HASH);
+    // --- All-in timeline ---
+    // The sequence and the earliest time each step may fire are planned once when the all-in starts.
+    // Every tick each open step fires as soon as the step it really depends on (R before the follow-ups,
+    // the shadow before the swap) is resolved, so a blocked E never holds back an unrelated Q. A step
+    // whose window stays blocked is dropped after STEP_TIMEOUT.
+    constexpr float R_DASH_TIME = 0.75f;        // R cast until Zed lands behind the target
+    constexpr float W_CAST_TIME = 0.1f;
+    constexpr float W_SHADOW_SPEED = 2500.0f;
+    constexpr float Q_CAST_TIME = 0.25f;
+    constexpr float STEP_TIMEOUT = 1.0f;
+    constexpr float TIMELINE_MAX = 4.0f;
+    constexpr int MAX_STEPS = 5;
+
+    enum class allin_step
+    {
+        r_mark,
+        w_shadow,
+        e_slash,
+        q_shuriken,
+        w_swap
+    };
+
+    enum class step_state
+    {
+        pending,
+        fired,
+        dropped
+    };
 
-        // 1) Cast R if ready and allowed on target
-        if (r->is_ready() && target->is_valid_target(r->range()) && can_use_r_on(target) && !is_overkill(target))
-        {
-            r->cast(target);
-            last_combo_time = now;
-            can_swap_back = false;
-        }
+    struct timeline_step
+    {
+        allin_step step;
+        float open_at;
+        // Step that has to be fired or dropped first; the step itself when there is none
+        allin_step after;
+        step_state state;
+        // First tick the step was tried and failed, the drop timeout counts from here
+        float blocked_since;
+    };
+
+    struct allin_timeline
+    {
+        bool active = false;
+        utils::entity_handle target;
+        float start = 0.0f;
+        timeline_step steps[MAX_STEPS] = {};
+        int step_count = 0;
+    };
+
+    static allin_timeline timeline;
+    static float last_w_cast_time = 0.0f;  // For W cooldown when auto W is OFF
+
+    void plan_allin(game_object_script target, float now)
+    {
+        timeline = allin_timeline{};
+        timeline.target = utils::make_handle(target);
+        timeline.start = now;
 
+        bool shadow_deployed = myhero->has_buff(SHADOWRUNNER_BUFF_HASH);
         bool w_toggle_on = w2_auto_cast_toggle && w2_auto_cast_toggle->get_bool();
         float manual_w_cd = manual_w_cooldown ? manual_w_cooldown->get_int() : 5;
+        bool save_q_for_r = combo_save_q_for_r && combo_save_q_for_r->get_bool();
+        // The slider is in 0.1 s steps
+        float swap_back_delay = (combo_swap_back_delay ? combo_swap_back_delay->get_int() : 7) * 0.1f;
+
+        auto add = [](allin_step step, float open_at, allin_step after) {
+            timeline.steps[timeline.step_count++] = { step, open_at, after, step_state::pending, -1.0f };
+        };
 
-        // 2) Cast W (shadow) if toggle ON, or toggle OFF but cooldown elapsed
-        if (w->is_ready() && !shadow_deployed && target->is_valid_target(w->range()))
+        // 1) R mark, Zed is untargetable and lands behind the target R_DASH_TIME later
+        bool use_r = r->is_ready() && target->is_valid_target(r->range()) && can_use_r_on(target) && !is_overkill(target);
+        float engage = now;
+        if (use_r)
         {
-            if (w_toggle_on)
-            {
-                // Auto W toggle ON: cast normally
-                w->cast(target->get_position());
-                last_w_cast_time = now;
-            }
-            else
-            {
-                // Auto W toggle OFF: only cast if cooldown passed
-                if (now - last_w_cast_time > manual_w_cd)
-                {
-                    w->cast(target->get_position());
-                    last_w_cast_time = now;
-                }
-            }
+            add(allin_step::r_mark, now, allin_step::r_mark);
+            engage = now + R_DASH_TIME;
+        }
+
+        // 2) W shadow from where Zed will be, it needs to travel before E/Q from it line up
+        bool use_w = w->is_ready() && !shadow_deployed && target->is_valid_target(w->range())
+            && (w_toggle_on || now - last_w_cast_time > manual_w_cd);
+        float shadow_ready = engage;
+        if (use_w)
+        {
+            add(allin_step::w_shadow, engage, use_r ? allin_step::r_mark : allin_step::w_shadow);
+            shadow_ready = engage + W_CAST_TIME + std::min(myhero->get_distance(target), w->range()) / W_SHADOW_SPEED;
         }
 
-        // 3) Cast E slash if ready and target in range of either hero or shadow
+        // 3) E as soon as hero or shadow covers the target
         if (e->is_ready())
+            add(allin_step::e_slash, target->is_valid_target(e->range()) && !use_r ? now : shadow_ready,
+                use_r ? allin_step::r_mark : allin_step::e_slash);
+
+        // 4) Q held for after the R proc, otherwise thrown once the shadow mirrors it
+        if (q->is_ready())
+            add(allin_step::q_shuriken, save_q_for_r && use_r ? engage : shadow_ready,
+                use_r ? allin_step::r_mark : allin_step::q_shuriken);
+
+        // 5) W2 swap back
+        if (w_toggle_on && (use_w || shadow_deployed))
         {
-            auto shadow_pos = get_shadow_position();
-            bool target_in_range = target->is_valid_target(e->range()) ||
-            (shadow_pos != vector(0, 0, 0) && target->get_position().distance(shadow_pos) <= e->range());
+            add(allin_step::w_swap, std::max(now + swap_back_delay, shadow_ready + Q_CAST_TIME),
+                use_w ? allin_step::w_shadow : allin_step::w_swap);
+            tuner::begin_allin(target, shadow_ready + Q_CAST_TIME - now);
+        }
 
+        std::stable_sort(timeline.steps, timeline.steps + timeline.step_count, [](const timeline_step& a, const timeline_step& b)
+        {
+            return a.open_at < b.open_at;
+        });
+        timeline.active = timeline.step_count > 0;
+    }
+
+    // True when the step was cast (or can never be cast and should be dropped right away)
+    bool fire_step(allin_step step, game_object_script target, float now)
+    {
+        switch (step)
+        {
+            case allin_step::r_mark:
+                if (!r->is_ready() || !target->is_valid_target(r->range())) return false;
+                utils::cast(r, target);
+                return true;
+
+            case allin_step::w_shadow:
+                if (!w->is_ready() || myhero->has_buff(SHADOWRUNNER_BUFF_HASH) || !target->is_valid_target(w->range())) return false;
+                utils::cast(w, target->get_position());
+                last_w_cast_time = now;
+                return true;
+
+            case allin_step::e_slash:
+            {
+                if (!e->is_ready()) return false;
+                auto shadow_pos = get_shadow_position();
+                bool target_in_range = target->is_valid_target(e->range()) ||
+                    (shadow_pos != vector(0, 0, 0) && target->get_position().distance(shadow_pos) <= e->range());
+                if (!target_in_range) return false;
+                utils::cast(e);
+                return true;
+            }
 
-            if (target_in_range)
+            case allin_step::q_shuriken:
             {
-                e->cast();
+                bool holding = combo_save_q_for_r && combo_save_q_for_r->get_bool() && r->is_ready();
+                float range = holding && combo_q_hold_range ? static_cast<float>(combo_q_hold_range->get_int()) : q->range();
+                if (!q->is_ready() || !target->is_valid_target(range) || !q_in_reach(target) || q_path_blocked(target)) return false;
+                utils::cast(q, target);
+                return true;
             }
+
+            case allin_step::w_swap:
+                if (!w->is_ready() || !myhero->has_buff(SHADOWRUNNER_BUFF_HASH) || w->name().find("w2") == std::string::npos) return false;
+                if (utils::cast(w))
+                    tuner::mark_swap();
+                return true;
         }
+        return true;
+    }
 
-        // 4) Cast Q shuriken, optionally saved for after R cast
-        if (save_q_for_r && r->is_ready())
+    // A step may go once the step it waits for is no longer pending (fired, dropped or never planned)
+    bool dependency_resolved(const timeline_step& step)
+    {
+        if (step.after == step.step)
+            return true;
+        for (int i = 0; i < timeline.step_count; ++i)
         {
-            if (q->is_ready() && target->is_valid_target(q_hold_range))
-                q->cast(target);
+            if (timeline.steps[i].step == step.after)
+                return timeline.steps[i].state != step_state::pending;
         }
-        else
+        return true;
+    }
+
+    // Danger swap-back is outside the plan: W2 is the escape whatever step is still blocked
+    void danger_swap_back()
+    {
+        bool w_toggle_on = w2_auto_cast_toggle && w2_auto_cast_toggle->get_bool();
+        if (!w_toggle_on || !w->is_ready() || !myhero->has_buff(SHADOWRUNNER_BUFF_HASH) || w->name().find("w2") == std::string::npos)
+            return;
+        bool in_danger = myhero->get_health_percent() < 20 || myhero->count_enemies_in_range(800) > 2;
+        if (!in_danger || !utils::cast(w))
+            return;
+        tuner::mark_swap();
+
+        for (int i = 0; i < timeline.step_count; ++i)
         {
-            if (q->is_ready() && target->is_valid_target(q->range()))
-                q->cast(target);
+            if (timeline.steps[i].step == allin_step::w_swap && timeline.steps[i].state == step_state::pending)
+                timeline.steps[i].state = step_state::fired;
         }
+    }
 
-        // 5) W2 (swap) cast only if toggle ON and shadow deployed
-        if (w_toggle_on && w->is_ready() && shadow_deployed && w->name().find("w2") != std::string::npos)
+    void combo_simple_allin(game_object_script target)
+    {
+        float now = gametime->get_time();
+        danger_swap_back();
+
+        if (timeline.active && (timeline.target != utils::lookup_handle(target) || now - timeline.start > TIMELINE_MAX))
+            timeline.active = false;
+        if (!timeline.active)
         {
-            bool in_danger = myhero->get_health_percent() < 20 || myhero->count_enemies_in_range(800) > 2;
-            if (in_danger || now - last_combo_time > swap_back_delay)
+            plan_allin(target, now);
+            if (!timeline.active)
+                return;
+        }
+
+        // Steps are sorted by window, so a step resolved this tick unblocks its dependents in the same pass
+        bool pending_left = false;
+        for (int i = 0; i < timeline.step_count; ++i)
+        {
+            auto& step = timeline.steps[i];
+            if (step.state != step_state::pending)
+                continue;
+            if (now < step.open_at || !dependency_resolved(step))
+            {
+                pending_left = true;
+                continue;
+            }
+
+            if (fire_step(step.step, target, now))
             {
-                w->cast();  // W2 cast
-                can_swap_back = false;
+                step.state = step_state::fired;
+            }
+            else if (step.blocked_since >= 0.0f && now - step.blocked_since >= STEP_TIMEOUT)
+            {
+                step.state = step_state::dropped;
+                LUVVY_LOG(logger::level::debug, logger::make_message("zed all-in step dropped", static_cast<std::int32_t>(step.step)));
             }
             else
             {
-                can_swap_back = true;
+                if (step.blocked_since < 0.0f)
+                    step.blocked_since = now;
+                pending_left = true;
             }
         }
+
+        if (!pending_left)
+            timeline.active = false;
     }
 
     // --- Harass Logic: Only Q to avoid crashes ---
@@ -275,8 +447,8 @@ namespace zed
         if (harass_min_mana && myhero->get_mana_percent() < harass_min_mana->get_int())
             return;
 
-        if (harass_use_q && harass_use_q->get_bool() && q->is_ready() && target->is_valid_target(q->range()))
-            q->cast(target);
+        if (harass_use_q && harass_use_q->get_bool() && q->is_ready() && target->is_valid_target(q->range()) && q_in_reach(target) && !q_path_blocked(target))
+            utils::cast(q, target);
     }
 
     // --- Killsteal logic ---
@@ -289,9 +461,9 @@ namespace zed
 
             if (killsteal_q && killsteal_q->get_bool() && q->is_ready() && target->is_valid_target(q->range()))
             {
-                if (get_q_damage(target) > target->get_health())
+                if (get_q_damage(target) > target->get_health() && q_in_reach(target) && !q_path_blocked(target))
                 {
-                    q->cast(target);
+                    utils::cast(q, target);
                     continue;
                 }
             }
@@ -300,7 +472,7 @@ namespace zed
             {
                 if (get_e_damage(target) > target->get_health())
                 {
-                    e->cast();
+                    utils::cast(e);
                     continue;
                 }
             }
@@ -309,7 +481,7 @@ namespace zed
             {
                 if (!is_overkill(target) && get_r_damage(target) > target->get_health())
                 {
-                    r->cast(target);
+                    utils::cast(r, target);
                     continue;
                 }
             }
@@ -319,41 +491,82 @@ namespace zed
     // --- Farming Logic for lane and jungle ---
     void farm_logic()
     {
-        if (spellfarm_key && spellfarm_key->get_bool() && (orbwalker->lane_clear_mode() || orbwalker->last_hit_mode()))
+        if (!watchdog::should_run_farm())
+            return;
+
+        // Lane work only when a wave reaches Q range at all
+        bool wave_near = waves::count_in_range(myhero->get_position(), q->range()) > 0;
+        if (wave_near && spellfarm_key && spellfarm_key->get_bool() && (orbwalker->lane_clear_mode() || orbwalker->last_hit_mode()))
         {
-            // Lane minions
+            // Lane minions: Q prefers a minion the shuriken will actually last-hit
+            bool q_cast = false;
+            if (farm_use_q && farm_use_q->get_bool() && q->is_ready())
+            {
+                for (auto& minion : entitylist->get_enemy_minions())
+                {
+                    if (!minion || !minion->is_valid() || minion->is_dead() || !minion->is_valid_target(q->range()))
+                        continue;
+
+                    float travel = q->delay + myhero->get_distance(minion) / q->speed;
+                    if (minion_health::is_killable(minion, static_cast<float>(q->get_damage(minion)), travel))
+                    {
+                        q_cast = utils::cast(q, minion);
+                        break;
+                    }
+                }
+            }
+
             for (auto& minion : entitylist->get_enemy_minions())
             {
                 if (!minion || !minion->is_valid() || minion->is_dead())
                     continue;
 
-                if (farm_use_q && farm_use_q->get_bool() && q->is_ready() && minion->is_valid_target(q->range()))
-                    q->cast(minion);
+                if (!q_cast && farm_use_q && farm_use_q->get_bool() && q->is_ready() && minion->is_valid_target(q->range()))
+                    utils::cast(q, minion);
 
                 if (farm_use_w && farm_use_w->get_bool() && w->is_ready() && minion->is_valid_target(w->range()))
-                    w->cast(minion->get_position());
+                    utils::cast(w, minion->get_position());
 
                 if (farm_use_e && farm_use_e->get_bool() && e->is_ready() && minion->is_valid_target(e->range()))
-                    e->cast();
+                    utils::cast(e);
             }
         }
 
         if (spellfarm_key && spellfarm_key->get_bool() && (orbwalker->lane_clear_mode() || orbwalker->last_hit_mode()))
         {
-            // Jungle mobs
-            for (auto& mob : entitylist->get_jugnle_mobs_minions())
+            // Jungle: aim Q/W at the camp's main monster, or the biggest one in range while it is out of
+            // reach; E as soon as anything in the camp is in range
+            auto pos = myhero->get_position();
+            auto camp = jungle::get_camp_in_range(pos, q->range());
+            auto mob = jungle::get_main_monster(camp);
+            if (mob)
             {
-                if (!mob || !mob->is_valid() || mob->is_dead())
-                    continue;
-
-                if (jungle_use_q && jungle_use_q->get_bool() && q->is_ready() && mob->is_valid_target(q->range()))
-                    q->cast(mob);
+                if (jungle_use_q && jungle_use_q->get_bool() && q->is_ready())
+                {
+                    auto q_mob = mob->is_valid_target(q->range()) ? mob : jungle::get_biggest_monster(camp, pos, q->range(), 0.0f);
+                    if (q_mob)
+                        utils::cast(q, q_mob);
+                }
 
-                if (jungle_use_w && jungle_use_w->get_bool() && w->is_ready() && mob->is_valid_target(w->range()))
-                    w->cast(mob->get_position());
+                if (jungle_use_w && jungle_use_w->get_bool() && w->is_ready())
+                {
+                    auto w_mob = mob->is_valid_target(w->range()) ? mob : jungle::get_biggest_monster(camp, pos, w->range(), 0.0f);
+                    if (w_mob)
+                        utils::cast(w, w_mob->get_position());
+                }
 
-                if (jungle_use_e && jungle_use_e->get_bool() && e->is_ready() && mob->is_valid_target(e->range()))
-                    e->cast();
+                if (jungle_use_e && jungle_use_e->get_bool() && e->is_ready())
+                {
+                    auto big = utils::resolve(camp->big);
+                    bool in_e_range = big && big->is_valid_target(e->range());
+                    for (int i = 0; !in_e_range && i < camp->small_count; ++i)
+                    {
+                        auto small = utils::resolve(camp->smalls[i]);
+                        in_e_range = small && small->is_valid_target(e->range());
+                    }
+                    if (in_e_range)
+                        utils::cast(e);
+                }
             }
         }
     }
@@ -361,7 +574,9 @@ namespace zed
     // --- Drawing Spell Ranges ---
     void on_draw()
     {
-        if (!myhero) return;
+        watchdog::scope timer("zed::on_draw");
+
+        if (!myhero || !watchdog::draw_range_circles()) return;
 
         if (draw_q_range && draw_q_range->get_bool() && q)
             draw_manager->add_circle(myhero->get_position(), q->range(), D3DCOLOR_ARGB(170, 70, 180, 255));
@@ -379,12 +594,18 @@ namespace zed
     // --- Main update loop, called every frame ---
     void on_update()
     {
+        alloc_counter::probe probe("zed::on_update");
+        watchdog::scope timer("zed::on_update");
+
         if (myhero->is_dead()) return;
 
         // Update W2 toggle from permashow menu
         if (w2_auto_cast_toggle)
             allow_w2_cast = w2_auto_cast_toggle->get_bool();
 
+        // Dodge lethal damage or CC ults with R (menu toggle, off by default)
+        defensive_r_logic();
+
         // Execute killsteal checks
         killsteal_logic();
 
@@ -396,6 +617,10 @@ namespace zed
         {
             combo_simple_allin(target);
         }
+        else
+        {
+            timeline.active = false;
+        }
 
         // Harass logic activation
         if (harass_key && harass_key->get_bool() && target)
@@ -411,15 +636,10 @@ namespace zed
     void load()
     {
         // Register spells with their ranges
-        q = plugin_sdk->register_spell(spellslot::q, 900);
-        w = plugin_sdk->register_spell(spellslot::w, 700);
-        e = plugin_sdk->register_spell(spellslot::e, 300);
-        r = plugin_sdk->register_spell(spellslot::r, 625);
-
-        // Setup Q as a skillshot
-        q->set_skillshot(0.25f, 50.f, 1700.f,
-            { collisionable_objects::heroes, collisionable_objects::yasuo_wall, collisionable_objects::minions },
-            skillshot_type::skillshot_line);
+        q = spell_data::register_spell(spell_data::zed::Q);
+        w = spell_data::register_spell(spell_data::zed::W);
+        e = spell_data::register_spell(spell_data::zed::E);
+        r = spell_data::register_spell(spell_data::zed::R);
 
         // Register flash if player has it
         auto s1 = myhero->get_spell(spellslot::summoner1)->get_spell_data()->get_name_hash();
@@ -431,6 +651,7 @@ namespace zed
 
         // Create main menu tab
         main_tab = menu->create_tab("zed", "Luvvy Zed");
+        utils::on_load(main_tab);
 
         // Combo tab and options
         auto combo_tab = main_tab->add_tab(".combo", "Combo");
@@ -470,7 +691,9 @@ namespace zed
 
         // R blacklist menu - disable R on specific champs
         auto rlogic_tab = main_tab->add_tab(".rlogic", "R Target");
-        r_blacklist_entries.clear();
+        defensive_r = rlogic_tab->add_checkbox(".defensive_r", "Dodge lethal damage / CC ults with R", true);
+        r_allowed = hero_table::column{};
+        hero_table::add_column(&r_allowed);
         for (auto& enemy : entitylist->get_enemy_heroes())
         {
             if (!enemy || !enemy->is_valid() || enemy->is_dead())
@@ -480,7 +703,7 @@ namespace zed
             std::transform(champ_name.begin(), champ_name.end(), champ_name.begin(), ::tolower);
 
             TreeEntry* chk = rlogic_tab->add_checkbox(".rblacklist." + champ_name, champ_name + " Use R", true);
-            r_blacklist_entries[champ_name] = chk;
+            hero_table::bind_entry(r_allowed, enemy, chk);
         }
 
         // Draw tab menu
@@ -500,7 +723,6 @@ namespace zed
         // Register event callbacks
         event_handler<events::on_update>::add_callback(on_update);
         event_handler<events::on_draw>::add_callback(on_draw);
-        event_handler<events::on_process_spell_cast>::add_callback(on_process_spell_cast);
     }
 
     // --- Unload plugin clean up ---
@@ -508,8 +730,8 @@ namespace zed
     {
         event_handler<events::on_update>::remove_handler(on_update);
         event_handler<events::on_draw>::remove_handler(on_draw);
-        event_handler<events::on_process_spell_cast>::remove_handler(on_process_spell_cast);
         Permashow::Instance.Destroy();
+        hero_table::remove_column(&r_allowed);
         menu->delete_tab(main_tab);
     }
 }
@@ -2,32 +2,44 @@
 #include "../plugin_sdk/plugin_sdk.hpp"
 #include <string>
 #include "utils.h"
+#include "alloc_counter.h"
+#include "watchdog.h"
+#include "turrets.h"
+#include "forecast.h"
+#include "minion_health.h"
+#include "worker.h"
+#include "tuner.h"
+#include "spell_data.h"
+#include "waves.h"
+#include "hero_table.h"
 #include "permashow.hpp"
 #include <algorithm>
 #include <vector>
+#include <array>
+#include <cstring>
 #include <unordered_set>
 
 namespace zilean
 {
-    constexpr float Q_RANGE = 900.0f;
-    constexpr float W_RANGE = 700.0f;
-    constexpr float E_RANGE = 550.0f;
-    constexpr float R_RANGE = 900.0f;
-    constexpr float Q_RADIUS = 150.0f;
+    constexpr float Q_RANGE = spell_data::zilean::Q.range;
+    constexpr float E_RANGE = spell_data::zilean::E.range;
+    constexpr float R_RANGE = spell_data::zilean::R.range;
+    constexpr float Q_RADIUS = spell_data::zilean::Q.aoe_radius;
+    constexpr float FARM_KILL_WEIGHT = 1.0f;
 
     static script_spell* q = nullptr;
     static script_spell* w = nullptr;
     static script_spell* e = nullptr;
     static script_spell* r = nullptr;
 
-    static uint32_t combo_target_id = 0;
+    static utils::entity_handle combo_target;
     static float combo_q1_cast_time = 0.0f;
     static bool waiting_for_qwq = false;
 
     // --- QWQ FARM STATE ---
     static bool waiting_for_farm_qwq = false;
     static float farm_q1_cast_time = 0.0f;
-    static game_object_script farm_qwq_target = nullptr;
+    static utils::entity_handle farm_qwq_target;
 
     namespace settings
     {
@@ -59,31 +71,157 @@ namespace zilean
 
     hit_chance get_hitchance_by_config(TreeEntry* hit)
     {
+        hit_chance value = hit_chance::high;
         switch (hit ? hit->get_int() : 2)
         {
-            case 0: return hit_chance::low;
-            case 1: return hit_chance::medium;
-            case 2: return hit_chance::high;
-            case 3: return hit_chance::very_high;
-            default: return hit_chance::high;
+            case 0: value = hit_chance::low; break;
+            case 1: value = hit_chance::medium; break;
+            case 3: value = hit_chance::very_high; break;
+            default: break;
         }
+        // Capped while the watchdog sheds work
+        return watchdog::clamp_hitchance(value);
     }
 
-    bool has_zilean_bomb(const game_object_script& obj)
+    // --- BOMB TRACKER ---
+    // Our bombs, fed only by buff and object events. A bomb is either attached to a unit (handle)
+    // or lying on the ground (object id), and detonates at a known time, so nothing polls bufflists.
+    constexpr int MAX_BOMBS = 8;
+    constexpr float BOMB_DURATION = 3.0f;
+    // Slack between Q1 landing and its buff/object event showing up
+    constexpr float BOMB_ATTACH_GRACE = 0.25f;
+
+    struct bomb
+    {
+        bool active = false;
+        utils::entity_handle carrier;
+        uint32_t object_id = 0;
+        float x = 0.0f;
+        float y = 0.0f;
+        float detonate_at = 0.0f;
+    };
+
+    static std::array<bomb, MAX_BOMBS> bombs;
+
+    bool is_bomb_buff(const buff_instance_script& buff)
+    {
+        if (!buff || !buff->is_valid() || buff->get_caster() != myhero.get())
+            return false;
+        auto name = buff->get_name_cstr();
+        return name && (std::strstr(name, "ZileanQEnemy") || std::strstr(name, "ZileanQAttach") || std::strstr(name, "ZileanQBuff"));
+    }
+
+    bool is_ground_bomb(const game_object_script& obj)
+    {
+        if (!obj || obj->is_missile() || !obj->is_ally())
+            return false;
+        auto name = obj->get_name_cstr();
+        return name && std::strstr(name, "Zilean") && std::strstr(name, "TimeBomb");
+    }
+
+    // Expired entries count as free, detonation needs no separate cleanup pass
+    bomb* acquire_bomb_slot(float now)
     {
-        if (!obj || !obj->is_valid()) return false;
-        for (const auto& buff : obj->get_bufflist())
+        for (auto& b : bombs)
         {
-            if (buff && buff->is_valid())
-            {
-                std::string name = buff->get_name();
-                if (name.find("ZileanQEnemy") != std::string::npos ||
-                    name.find("ZileanQAttach") != std::string::npos ||
-                    name.find("ZileanQBuff") != std::string::npos)
-                    return true;
-            }
+            if (!b.active || b.detonate_at <= now)
+                return &b;
+        }
+        // Full: reuse the bomb that pops first
+        return &*std::min_element(bombs.begin(), bombs.end(), [](const bomb& a, const bomb& b) {
+            return a.detonate_at < b.detonate_at;
+        });
+    }
+
+    const bomb* find_bomb(utils::entity_handle carrier)
+    {
+        if (!carrier.is_set())
+            return nullptr;
+        float now = gametime->get_time();
+        for (auto& b : bombs)
+        {
+            if (b.active && b.carrier == carrier && b.detonate_at > now)
+                return &b;
+        }
+        return nullptr;
+    }
+
+    bool has_bomb(const game_object_script& unit)
+    {
+        return unit && find_bomb(utils::lookup_handle(unit)) != nullptr;
+    }
+
+    // Time for a Q cast now to land on the unit
+    float q_travel_time(const game_object_script& unit)
+    {
+        return spell_data::zilean::Q.delay + myhero->get_distance(unit) / spell_data::zilean::Q.speed;
+    }
+
+    // True while a follow-up Q can still stack on the first: Q1 in the air or a bomb that has not popped yet
+    bool can_stack_bomb(const game_object_script& unit, float q1_cast_time)
+    {
+        float now = gametime->get_time();
+        float travel = q_travel_time(unit);
+        if (auto b = find_bomb(utils::lookup_handle(unit)))
+            return b->detonate_at - now > travel;
+        return now - q1_cast_time <= travel + BOMB_ATTACH_GRACE;
+    }
+
+    void on_buff_gain(game_object_script sender, buff_instance_script buff)
+    {
+        if (!sender || !is_bomb_buff(buff))
+            return;
+
+        auto carrier = utils::make_handle(sender);
+        float now = gametime->get_time();
+        bomb* slot = nullptr;
+        for (auto& b : bombs)
+        {
+            if (b.active && b.carrier == carrier)
+                slot = &b;
+        }
+        if (!slot)
+            slot = acquire_bomb_slot(now);
+
+        auto pos = sender->get_position();
+        float end = buff->get_end();
+        *slot = { true, carrier, 0, pos.x, pos.y, end > now ? end : now + BOMB_DURATION };
+    }
+
+    void on_buff_lose(game_object_script sender, buff_instance_script buff)
+    {
+        if (!sender || !is_bomb_buff(buff))
+            return;
+
+        auto carrier = utils::lookup_handle(sender);
+        for (auto& b : bombs)
+        {
+            if (b.active && b.carrier == carrier)
+                b.active = false;
+        }
+    }
+
+    void on_create_object(game_object_script sender)
+    {
+        if (!is_ground_bomb(sender))
+            return;
+
+        float now = gametime->get_time();
+        auto pos = sender->get_position();
+        *acquire_bomb_slot(now) = { true, {}, sender->get_id(), pos.x, pos.y, now + BOMB_DURATION };
+    }
+
+    void on_delete_object(game_object_script sender)
+    {
+        if (!sender)
+            return;
+
+        auto id = sender->get_id();
+        for (auto& b : bombs)
+        {
+            if (b.active && !b.carrier.is_set() && b.object_id == id)
+                b.active = false;
         }
-        return false;
     }
 
     float get_safe_q_range()
@@ -108,17 +246,18 @@ namespace zilean
         return false;
     }
 
-    game_object_script get_best_ally_for(TreeEntry* prio_list, const std::vector<game_object_script>& allies)
+    // E priority list mirrored into hero slots, already sorted and filtered by the change callback
+    static hero_table::column e_priorities;
+
+    game_object_script get_best_ally_for(const hero_table::column& priorities)
     {
-        std::vector<std::pair<game_object_script, int>> valid;
-        for (auto& a : allies)
+        for (int i = 0; i < priorities.order_count; ++i)
         {
-            auto pr = prio_list->get_prority(a->get_network_id());
-            if (pr.first == -1 || !pr.second) continue;
-            valid.push_back({ a, pr.first });
+            auto ally = hero_table::hero_at(priorities.order[i]);
+            if (ally && ally->is_valid())
+                return ally;
         }
-        std::sort(valid.begin(), valid.end(), [](auto& a, auto& b) { return a.second < b.second; });
-        return valid.empty() ? nullptr : valid.front().first;
+        return nullptr;
     }
 
     static const std::vector<std::string> channel_ult_buffs = {
@@ -200,9 +339,9 @@ namespace zilean
 
             if (q && q->is_ready() && dist < safe_q_range)
             {
-                if (q->cast(target, hc))
+                if (utils::cast(q, target, hc))
                 {
-                    combo_target_id = target->get_network_id();
+                    combo_target = utils::make_handle(target);
                     combo_q1_cast_time = now;
                     waiting_for_qwq = do_double_bomb;
                     return;
@@ -213,30 +352,29 @@ namespace zilean
                 int e_mode = settings::e_mode ? settings::e_mode->get_int() : 0;
                 if (e_mode == 0)
                 {
-                    std::vector<game_object_script> allies = entitylist->get_ally_heroes();
-                    auto best_e = get_best_ally_for(settings::e_priority_list, allies);
+                    auto best_e = get_best_ally_for(e_priorities);
                     if (best_e && best_e->is_me() && !e_is_on_self())
-                        e->cast(best_e);
+                        utils::cast(e, best_e);
                 }
             }
             return;
         }
 
-        if (waiting_for_qwq && target->get_network_id() == combo_target_id)
+        if (waiting_for_qwq && utils::lookup_handle(target) == combo_target)
         {
-            if (now - combo_q1_cast_time > 1.8f)
+            if (!can_stack_bomb(target, combo_q1_cast_time))
             {
                 waiting_for_qwq = false;
                 return;
             }
             if (w && w->is_ready())
             {
-                w->cast();
+                utils::cast(w);
                 return;
             }
             if (q && q->is_ready())
             {
-                if (q->cast(target, hc))
+                if (utils::cast(q, target, hc))
                 {
                     waiting_for_qwq = false;
                     return;
@@ -246,7 +384,7 @@ namespace zilean
             {
                 int e_mode = settings::e_mode ? settings::e_mode->get_int() : 1;
                 if (e_mode == 1 && dist <= E_RANGE && !target->has_buff_type(buff_type::Slow))
-                    e->cast(target);
+                    utils::cast(e, target);
             }
             return;
         }
@@ -258,136 +396,260 @@ namespace zilean
         if (e && e->is_ready() && myhero && !myhero->is_dead())
         {
             if (!e_is_on_self())
-                e->cast(myhero);
+                utils::cast(e, myhero);
         }
     }
 
+    // Same units and candidate centers solve_circle_farm builds from the snapshot
+    void record_farm_tick(const worker::snapshot& snap)
+    {
+        utils::frame_vector<circle_scoring::point> units;
+        utils::frame_vector<utils::entity_handle> handles;
+        utils::frame_vector<circle_scoring::point> centers;
+        units.reserve(snap.minion_count);
+        handles.reserve(snap.minion_count);
+        centers.reserve(snap.minion_count);
+
+        float range_sq = snap.farm_range * snap.farm_range;
+        for (int i = 0; i < snap.minion_count; ++i)
+        {
+            const auto& m = snap.minions[i];
+            units.push_back({ m.x, m.y, m.killable });
+            handles.push_back(m.handle);
+            float hx = m.x - snap.hero_x, hy = m.y - snap.hero_y;
+            if (hx * hx + hy * hy <= range_sq)
+                centers.push_back(units.back());
+        }
+
+        // A bomb on a minion only goes off when it runs out, unless a second one detonates it early
+        float impact_window = spell_data::zilean::Q.delay + Q_RANGE / spell_data::zilean::Q.speed + BOMB_DURATION;
+        tuner::record_farm(spellslot::q, units.data(), handles.data(), snap.minion_count, centers.data(), static_cast<int>(centers.size()),
+            snap.farm_radius, snap.farm_kill_weight, tuner_format::farm_policy::best_score, impact_window);
+    }
+
     void farm_with_q()
     {
         if (!settings::farm_q || !settings::farm_q->get_bool()) return;
         if (!q || !q->is_ready()) return;
         if (settings::farm_hotkey && !settings::farm_hotkey->get_bool()) return;
-
-        auto minions = entitylist->get_enemy_minions();
-        if (minions.empty()) return;
-
-        int best_count = 0;
-        game_object_script best_minion = nullptr;
-        for (auto& m : minions)
+        if (!watchdog::should_run_farm()) return;
+
+        // Only waves that reach the Q circle go into the snapshot, the rest never needs a kill forecast
+        int cluster_count = 0;
+        auto clusters = waves::get_clusters(&cluster_count);
+        auto hero_pos = myhero->get_position();
+        if (waves::count_in_range(hero_pos, Q_RANGE + Q_RADIUS) == 0) return;
+
+        // Plain-data snapshot of the wave; kill forecasts need the SDK so they are filled in here
+        auto& snap = worker::begin_snapshot();
+        snap.tick = utils::get_tick();
+        snap.hero_x = hero_pos.x;
+        snap.hero_y = hero_pos.y;
+        snap.farm_range = Q_RANGE;
+        snap.farm_radius = Q_RADIUS;
+        snap.farm_kill_weight = FARM_KILL_WEIGHT;
+        for (int c = 0; c < cluster_count; ++c)
         {
-            if (!m || !m->is_valid() || m->is_dead() || m->get_distance(myhero) > Q_RANGE)
-                continue;
-
-            int count = 0;
-            for (auto& n : minions)
+            if (!waves::reaches(clusters[c], hero_pos, Q_RANGE + Q_RADIUS)) continue;
+            auto members = waves::get_members(clusters[c]);
+            for (int i = 0; i < clusters[c].count && snap.minion_count < worker::MAX_UNITS; ++i)
             {
-                if (!n || n->is_dead() || n->get_distance(m) > Q_RADIUS)
-                    continue;
-                count++;
-            }
-            if (count > best_count)
-            {
-                best_count = count;
-                best_minion = m;
+                auto& n = members[i];
+                if (!n || !n->is_valid() || n->is_dead()) continue;
+                auto pos = n->get_position();
+                float travel = spell_data::zilean::Q.delay + pos.distance(hero_pos) / spell_data::zilean::Q.speed;
+                snap.minions[snap.minion_count++] = { pos.x, pos.y, utils::make_handle(n), minion_health::is_killable(n, static_cast<float>(q->get_damage(n)), travel) };
             }
         }
 
+        if (tuner::is_recording())
+            record_farm_tick(snap);
+
+        // Worker mode answers from the previous tick's snapshot; stale results are rejected
+        worker::farm_result best;
+        if (worker::is_enabled())
+        {
+            auto tick = snap.tick;
+            worker::publish_snapshot();
+            if (!worker::get_farm_result(tick, best)) return;
+        }
+        else
+        {
+            best = worker::solve_circle_farm(snap);
+        }
+
+        game_object_script best_minion = best.index >= 0 ? utils::resolve(best.handle) : nullptr;
+        if (best_minion && (best_minion->is_dead() || best_minion->get_distance(myhero) > Q_RANGE))
+            best_minion = nullptr;
+        int best_count = best.count;
+
         int min_minions_for_qwq = settings::farm_qwq_min ? settings::farm_qwq_min->get_int() : 6;
         bool use_w_in_farm = settings::farm_w ? settings::farm_w->get_bool() : true;
 
         if (!waiting_for_farm_qwq && use_w_in_farm && best_minion && best_count >= min_minions_for_qwq && w && w->is_ready())
         {
-            if (q->cast(best_minion))
+            if (utils::cast(q, best_minion))
             {
                 waiting_for_farm_qwq = true;
-                farm_qwq_target = best_minion;
+                farm_qwq_target = utils::make_handle(best_minion);
                 farm_q1_cast_time = gametime->get_time();
             }
             return;
         }
         if (best_minion && !waiting_for_farm_qwq)
         {
-            q->cast(best_minion);
+            utils::cast(q, best_minion);
         }
     }
 
-    void try_cast_r()
+    // --- R DANGER ENGINE ---
+    // One threat score per R candidate, computed once per tick. A score above 1 means the ally needs R now.
+    constexpr float DANGER_ENEMY_RANGE = 750.0f;
+    constexpr float DANGER_DOT_SCORE = 1.5f;
+    constexpr float DANGER_FORECAST_WINDOW = 0.5f;
+
+    struct ally_danger
     {
-        if (!(settings::auto_r && settings::auto_r->get_bool() && r && r->is_ready())) return;
+        game_object_script hero = nullptr;
+        std::uint32_t network_id = 0;
+        int priority = -1;
+        bool enabled = false;
+        float score = 0.0f;
+    };
 
-        int min_hp = settings::r_min_hp ? settings::r_min_hp->get_int() : 15; // lowered from 20 to 15
-        bool save_allies = settings::r_save_allies ? settings::r_save_allies->get_bool() : true;
+    // Candidates stay sorted by cached R priority, so selection is a single forward pass
+    static std::vector<ally_danger> ally_dangers;
+    static std::vector<vector> enemy_positions;
+
+    static const std::vector<std::string> dot_buffs = {
+        "summonerdot",
+        "ignite",
+        "burn",
+        "deathmark",
+        "mordekaiserchildrenofthegrave",
+        "brandablaze",
+        "cassiopeiapoisontarget",
+        "fizzmarinerdoombomb"
+    };
 
-        auto is_in_danger = [](game_object_script hero) -> bool {
-            if (!hero || hero->is_dead()) return false;
-            for (auto& buff : hero->get_bufflist())
-            {
-                if (!buff || !buff->is_valid()) continue;
-                std::string n = buff->get_name();
-                if (n.find("ZileanR") != std::string::npos || n.find("ChronoRevive") != std::string::npos)
-                    return false;
-            }
-            for (auto& turret : entitylist->get_enemy_turrets())
-            {
-                if (turret && turret->is_valid() && !turret->is_dead() && turret->get_distance(hero) < 775)
-                    if (hero->get_health_percent() < 30) return true;
-            }
-            for (auto& buff : hero->get_bufflist())
-            {
-                if (!buff || !buff->is_valid()) continue;
-                std::string name = buff->get_name();
-                if (name.find("summonerdot") != std::string::npos
-                    || name.find("ignite") != std::string::npos
-                    || name.find("burn") != std::string::npos
-                    || name.find("deathmark") != std::string::npos
-                    || name.find("mordekaiserchildrenofthegrave") != std::string::npos
-                    || name.find("brandablaze") != std::string::npos
-                    || name.find("cassiopeiapoisontarget") != std::string::npos
-                    || name.find("fizzmarinerdoombomb") != std::string::npos)
-                    return true;
-            }
-            int enemy_count = 0;
-            for (auto& enemy : entitylist->get_enemy_heroes())
-            {
-                if (enemy && enemy->is_valid() && !enemy->is_dead() && enemy->is_visible() && enemy->get_distance(hero) < 750)
-                    enemy_count++;
-            }
-            if (enemy_count >= 2 && hero->get_health_percent() < 40) return true;
-            return false;
-        };
+    void refresh_r_priorities()
+    {
+        if (!settings::r_priority_list) return;
+        for (auto& entry : ally_dangers)
+        {
+            auto pr = settings::r_priority_list->get_prority(entry.network_id);
+            entry.priority = pr.first;
+            entry.enabled = pr.first != -1 && pr.second;
+        }
+        std::stable_sort(ally_dangers.begin(), ally_dangers.end(), [](const ally_danger& a, const ally_danger& b) {
+            return a.priority < b.priority;
+        });
+    }
 
-        if (settings::r_priority_list)
+    void on_r_priority_change(TreeEntry*)
+    {
+        refresh_r_priorities();
+    }
+
+    void build_ally_dangers()
+    {
+        ally_dangers.clear();
+        bool has_me = false;
+        for (auto&& ally : entitylist->get_ally_heroes())
         {
-            std::vector<game_object_script> all_candidates = entitylist->get_ally_heroes();
-            all_candidates.push_back(myhero);
+            if (!ally || !ally->is_valid()) continue;
+            has_me = has_me || ally->is_me();
+            ally_dangers.push_back({ ally, ally->get_network_id() });
+        }
+        if (!has_me)
+            ally_dangers.push_back({ myhero, myhero->get_network_id() });
+        refresh_r_priorities();
+    }
 
-            std::sort(all_candidates.begin(), all_candidates.end(), [&](const game_object_script& a, const game_object_script& b) {
-                auto pa = settings::r_priority_list->get_prority(a->get_network_id());
-                auto pb = settings::r_priority_list->get_prority(b->get_network_id());
-                return pa.first < pb.first;
-            });
+    float compute_danger_score(const ally_danger& entry, int min_hp)
+    {
+        auto& hero = entry.hero;
+        if (!hero || !hero->is_valid() || hero->is_dead() || myhero->get_distance(hero) > R_RANGE)
+            return 0.0f;
 
-            for (auto& ally : all_candidates)
+        bool has_dot = false;
+        for (const auto& buff : hero->get_bufflist())
+        {
+            if (!buff || !buff->is_valid()) continue;
+            std::string name = buff->get_name();
+            if (name.find("ZileanR") != std::string::npos || name.find("ChronoRevive") != std::string::npos)
+                return 0.0f;
+            if (!has_dot)
             {
-                if (!ally || ally->is_dead() || myhero->get_distance(ally) > R_RANGE) continue;
-                auto pr = settings::r_priority_list->get_prority(ally->get_network_id());
-                if (pr.first == -1 || !pr.second) continue;
-                bool already_reviving = false;
-                for (auto& buff : ally->get_bufflist())
+                for (const auto& dot : dot_buffs)
                 {
-                    if (!buff || !buff->is_valid()) continue;
-                    std::string n = buff->get_name();
-                    if (n.find("ZileanR") != std::string::npos || n.find("ChronoRevive") != std::string::npos)
-                        already_reviving = true;
-                }
-                if (already_reviving) continue;
-                if (ally->get_health_percent() < min_hp || is_in_danger(ally))
-                {
-                    r->cast(ally);
-                    return;
+                    if (name.find(dot) != std::string::npos)
+                    {
+                        has_dot = true;
+                        break;
+                    }
                 }
             }
         }
+
+        float hp = std::max(hero->get_health_percent(), 0.01f);
+        auto pos = hero->get_position();
+
+        // Everything but the HP term first, the tuner sweeps r_min_hp against it
+        float score = 0.0f;
+        if (has_dot)
+            score = std::max(score, DANGER_DOT_SCORE);
+        if (turrets::is_in_enemy_range(pos))
+            score = std::max(score, 30.0f / hp);
+
+        int enemy_count = 0;
+        for (const auto& enemy_pos : enemy_positions)
+        {
+            if (enemy_pos.distance(pos) < DANGER_ENEMY_RANGE)
+                enemy_count++;
+        }
+        if (enemy_count >= 2)
+            score = std::max(score, 40.0f / hp);
+
+        // Forecast damage that would kill the ally before R lands
+        float incoming = forecast::get_incoming_damage(hero, DANGER_FORECAST_WINDOW);
+        if (incoming > 0.0f)
+            score = std::max(score, incoming / std::max(hero->get_health(), 1.0f));
+
+        tuner::record_ally(hero, hp, score);
+        return std::max(score, min_hp / hp);
+    }
+
+    void update_ally_dangers(int min_hp)
+    {
+        enemy_positions.clear();
+        for (auto& enemy : entitylist->get_enemy_heroes())
+        {
+            if (enemy && enemy->is_valid() && !enemy->is_dead() && enemy->is_visible())
+                enemy_positions.push_back(enemy->get_position());
+        }
+
+        for (auto& entry : ally_dangers)
+            entry.score = entry.enabled ? compute_danger_score(entry, min_hp) : 0.0f;
+    }
+
+    void try_cast_r()
+    {
+        if (!(settings::auto_r && settings::auto_r->get_bool() && r && r->is_ready())) return;
+        if (!settings::r_priority_list) return;
+
+        int min_hp = settings::r_min_hp ? settings::r_min_hp->get_int() : 15; // lowered from 20 to 15
+
+        update_ally_dangers(min_hp);
+
+        for (auto& entry : ally_dangers)
+        {
+            if (entry.score > 1.0f)
+            {
+                utils::cast(r, entry.hero);
+                return;
+            }
+        }
     }
 
     void anti_melee_logic()
@@ -402,7 +664,7 @@ namespace zilean
             {
                 if (!e_is_on_self())
                 {
-                    e->cast(myhero);
+                    utils::cast(e, myhero);
                     break;
                 }
             }
@@ -415,15 +677,14 @@ namespace zilean
         if (!myhero || myhero->is_dead()) return;
         if (!e_is_on_self())
         {
-            e->cast(myhero);
+            utils::cast(e, myhero);
             return;
         }
         if (settings::e_priority_list)
         {
-            std::vector<game_object_script> allies = entitylist->get_ally_heroes();
-            auto best = get_best_ally_for(settings::e_priority_list, allies);
+            auto best = get_best_ally_for(e_priorities);
             if (best && best->is_valid() && !best->is_dead() && best->get_distance(myhero) <= E_RANGE && !best->is_me())
-                e->cast(best);
+                utils::cast(e, best);
         }
     }
 
@@ -445,37 +706,35 @@ namespace zilean
             }
         }
         if (closest)
-            e->cast(closest);
+            utils::cast(e, closest);
     }
 
     void on_update()
     {
+        alloc_counter::probe probe("zilean::on_update");
+        watchdog::scope timer("zilean::on_update");
+
         if (!myhero || myhero->is_dead()) return;
 
         if (waiting_for_farm_qwq)
         {
-            if (!farm_qwq_target || !farm_qwq_target->is_valid() || farm_qwq_target->is_dead())
+            auto target = utils::resolve(farm_qwq_target);
+            if (!target || target->is_dead() || !can_stack_bomb(target, farm_q1_cast_time))
             {
                 waiting_for_farm_qwq = false;
-                farm_qwq_target = nullptr;
+                farm_qwq_target = {};
             }
             else
             {
-                float now = gametime->get_time();
                 if (w && w->is_ready())
                 {
-                    w->cast();
+                    utils::cast(w);
                 }
                 if (q && q->is_ready())
                 {
-                    q->cast(farm_qwq_target);
-                    waiting_for_farm_qwq = false;
-                    farm_qwq_target = nullptr;
-                }
-                if (now - farm_q1_cast_time > 2.0f)
-                {
+                    utils::cast(q, target);
                     waiting_for_farm_qwq = false;
-                    farm_qwq_target = nullptr;
+                    farm_qwq_target = {};
                 }
             }
         }
@@ -493,13 +752,12 @@ namespace zilean
                 if (active_spell && is_gapclose_spell(active_spell))
                 {
                     if (e && e->is_ready() && myhero->get_distance(enemy) <= E_RANGE)
-                        e->cast(enemy);
+                        utils::cast(e, enemy);
+                    // W only resets Q once the first bomb is on them, a missed Q1 keeps W for later
+                    if (has_bomb(enemy) && q && !q->is_ready() && w && w->is_ready())
+                        utils::cast(w);
                     if (q && q->is_ready() && myhero->get_distance(enemy) <= Q_RANGE)
-                        q->cast(enemy);
-                    if (w && w->is_ready())
-                        w->cast();
-                    if (q && q->is_ready() && myhero->get_distance(enemy) <= Q_RANGE)
-                        q->cast(enemy);
+                        utils::cast(q, enemy);
                     break;
                 }
             }
@@ -530,16 +788,19 @@ namespace zilean
 
     void on_draw()
     {
+        watchdog::scope timer("zilean::on_draw");
+
         if (!myhero) return;
         auto pos = myhero->get_position();
+        bool circles = watchdog::draw_range_circles();
 
-        if (settings::draw_range_q && settings::draw_range_q->get_bool())
+        if (circles && settings::draw_range_q && settings::draw_range_q->get_bool())
             draw_manager->add_circle(pos, Q_RANGE, D3DCOLOR_ARGB(120, 50, 200, 255));
-        if (settings::draw_range_e && settings::draw_range_e->get_bool())
+        if (circles && settings::draw_range_e && settings::draw_range_e->get_bool())
             draw_manager->add_circle(pos, E_RANGE, D3DCOLOR_ARGB(120, 120, 255, 0));
-        if (settings::draw_range_r && settings::draw_range_r->get_bool())
+        if (circles && settings::draw_range_r && settings::draw_range_r->get_bool())
             draw_manager->add_circle(pos, R_RANGE, D3DCOLOR_ARGB(80, 255, 50, 50));
-        if (settings::safe_q_range_slider && settings::draw_range_q && settings::draw_range_q->get_bool())
+        if (circles && settings::safe_q_range_slider && settings::draw_range_q && settings::draw_range_q->get_bool())
             draw_manager->add_circle(pos, get_safe_q_range(), D3DCOLOR_ARGB(80, 100, 255, 200));
 
         vector draw_pos = pos;
@@ -559,10 +820,10 @@ namespace zilean
 
     void load()
     {
-        q = plugin_sdk->register_spell(spellslot::q, Q_RANGE);
-        w = plugin_sdk->register_spell(spellslot::w, W_RANGE);
-        e = plugin_sdk->register_spell(spellslot::e, E_RANGE);
-        r = plugin_sdk->register_spell(spellslot::r, R_RANGE);
+        q = spell_data::register_spell(spell_data::zilean::Q);
+        w = spell_data::register_spell(spell_data::zilean::W);
+        e = spell_data::register_spell(spell_data::zilean::E);
+        r = spell_data::register_spell(spell_data::zilean::R);
 
         if (!q || !w || !e || !r)
         {
@@ -570,9 +831,9 @@ namespace zilean
             return;
         }
 
-        q->set_skillshot(0.28f, 150.0f, 1100.0f, {}, skillshot_type::skillshot_circle);
-
         settings::main_tab = menu->create_tab("carry.zilean", "Zilean");
+        utils::on_load(settings::main_tab);
+
         auto main = settings::main_tab->add_tab("carry.zilean.main", "Main");
         settings::auto_q = main->add_checkbox("carry.zilean.main.q", "Auto Q in combo", true);
         settings::q_double_bomb = main->add_checkbox("carry.zilean.q.doublebomb", "Try Double Bomb (Q twice)", true);
@@ -618,9 +879,19 @@ namespace zilean
         }
         settings::r_priority_list = r_prio_tab->add_prority_list("carry.zilean.rprio", "R Priority", ally_prio_items, false, false);
         settings::e_priority_list = e_prio_tab->add_prority_list("carry.zilean.eprio", "E Priority", ally_prio_items, false, false);
+        settings::r_priority_list->add_property_change_callback(on_r_priority_change);
+        e_priorities = hero_table::column{};
+        hero_table::add_column(&e_priorities);
+        hero_table::bind_priority_list(e_priorities, settings::e_priority_list);
+        build_ally_dangers();
 
+        bombs.fill(bomb{});
         event_handler<events::on_update>::add_callback(on_update);
         event_handler<events::on_draw>::add_callback(on_draw);
+        event_handler<events::on_buff_gain>::add_callback(on_buff_gain);
+        event_handler<events::on_buff_lose>::add_callback(on_buff_lose);
+        event_handler<events::on_create_object>::add_callback(on_create_object);
+        event_handler<events::on_delete_object>::add_callback(on_delete_object);
 
         Permashow::Instance.Init(settings::main_tab, "Zilean");
         Permashow::Instance.AddElement("Farm Q", settings::farm_hotkey);
@@ -638,8 +909,14 @@ namespace zilean
         if (w) plugin_sdk->remove_spell(w);
         if (e) plugin_sdk->remove_spell(e);
         if (r) plugin_sdk->remove_spell(r);
+        ally_dangers.clear();
+        hero_table::remove_column(&e_priorities);
         event_handler<events::on_update>::remove_handler(on_update);
         event_handler<events::on_draw>::remove_handler(on_draw);
+        event_handler<events::on_buff_gain>::remove_handler(on_buff_gain);
+        event_handler<events::on_buff_lose>::remove_handler(on_buff_lose);
+        event_handler<events::on_create_object>::remove_handler(on_create_object);
+        event_handler<events::on_delete_object>::remove_handler(on_delete_object);
         console->print("Zilean plugin unloaded!");
     }
 }